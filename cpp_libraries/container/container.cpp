@@ -1,8 +1,11 @@
 #include "container.h"
 
 #include "value_types.h"
+#include "field_scanner.h"
+#include "json_parser.h"
 #include "converting.h"
 #include "file_handling.h"
+#include "file_mapping.h"
 
 #include "values/container_value.h"
 
@@ -11,7 +14,9 @@
 #include <wchar.h>
 
 #include <regex>
+#include <cwctype>
 #include <sstream>
+#include <algorithm>
 
 #include "fmt/format.h"
 
@@ -27,9 +32,263 @@ namespace container
 	using namespace converting;
 	using namespace file_handling;
 
+	bool is_word(const wchar_t& character)
+	{
+		return (character >= L'a' && character <= L'z') || (character >= L'A' && character <= L'Z') || (character >= L'0' && character <= L'9') || character == L'_';
+	}
+
+	template <typename T> size_t utf8_width(const T& character)
+	{
+		if constexpr (sizeof(T) == 1)
+		{
+			return 1;
+		}
+		else
+		{
+			unsigned long code = static_cast<unsigned long>(character);
+			if (code < 0x80)
+			{
+				return 1;
+			}
+
+			if (code < 0x800)
+			{
+				return 2;
+			}
+
+			if (code >= 0xD800 && code < 0xDC00)
+			{
+				return 4;
+			}
+
+			if (code >= 0xDC00 && code < 0xE000)
+			{
+				return 0;
+			}
+
+			return (code < 0x10000) ? 3 : 4;
+		}
+	}
+
+	// matches ",f,<length>:" at position and locates the raw payload behind it
+	template <typename T> bool length_prefixed(const T& data, const size_t& position, const size_t& end, size_t& payload_offset, size_t& payload_end)
+	{
+		if (position + 4 >= end || data[position] != ',' || data[position + 1] != LENGTH_PREFIXED_STRING[0] || data[position + 2] != ',')
+		{
+			return false;
+		}
+
+		size_t current = position + 3;
+		size_t length = 0;
+		while (current < end && data[current] >= '0' && data[current] <= '9')
+		{
+			length = length * 10 + (data[current] - '0');
+			++current;
+		}
+
+		if (current == position + 3 || current >= end || data[current] != ':')
+		{
+			return false;
+		}
+
+		payload_offset = ++current;
+		while (current < end && (length > 0 || utf8_width(data[current]) == 0))
+		{
+			length -= (std::min)(length, utf8_width(data[current]));
+			++current;
+		}
+
+		if (length > 0)
+		{
+			return false;
+		}
+
+		payload_end = current;
+
+		return true;
+	}
+
+	template <typename T> void remove_newlines(T& data)
+	{
+		size_t target = 0;
+		size_t source = 0;
+		size_t payload_offset = 0;
+		size_t payload_end = 0;
+		while (source < data.size())
+		{
+			if (data[source] == ',' && length_prefixed(data, source, data.size(), payload_offset, payload_end))
+			{
+				while (source < payload_end)
+				{
+					data[target++] = data[source++];
+				}
+
+				continue;
+			}
+
+			if (data[source] != '\r' && data[source] != '\n')
+			{
+				data[target++] = data[source];
+			}
+
+			++source;
+		}
+
+		data.resize(target);
+	}
+
+	// read-only view over a byte range, so the section scanner works on mapped memory as well
+	struct byte_view
+	{
+		const unsigned char* data;
+		size_t length;
+
+		const unsigned char& operator[](const size_t& index) const { return data[index]; }
+		size_t size(void) const { return length; }
+	};
+
+	// finds the "};" closing a section, stepping over length-prefixed payloads
+	template <typename T> size_t find_section_end(const T& data, const size_t& offset)
+	{
+		size_t payload_offset = 0;
+		size_t payload_end = 0;
+		for (size_t position = offset; position + 1 < data.size(); ++position)
+		{
+			if (data[position] == ',' && length_prefixed(data, position, data.size(), payload_offset, payload_end))
+			{
+				position = payload_end - 1;
+				continue;
+			}
+
+			if (data[position] == '}' && data[position + 1] == ';')
+			{
+				return position;
+			}
+		}
+
+		return std::wstring::npos;
+	}
+
+	// scans the next [name,type,value]; entry in the same way as the former regex parser
+	bool next_field(const std::wstring& data, const size_t& end, size_t& position, field_token& token)
+	{
+		while (position < end)
+		{
+			size_t start = data.find(L'[', position);
+			if (start == std::wstring::npos || start >= end)
+			{
+				position = end;
+				return false;
+			}
+
+			size_t current = start + 1;
+			while (current < end && is_word(data[current]))
+			{
+				++current;
+			}
+
+			if (current == start + 1 || current >= end || data[current] != L',')
+			{
+				position = start + 1;
+				continue;
+			}
+
+			token.offset = start;
+			token.name_offset = start + 1;
+			token.name_length = current - token.name_offset;
+
+			++current;
+			while (current < end && (iswspace(data[current]) || data[current] == L'?'))
+			{
+				++current;
+			}
+
+			token.type_offset = current;
+			while (current < end && is_word(data[current]))
+			{
+				++current;
+			}
+
+			if (current == token.type_offset || current >= end || data[current] != L',')
+			{
+				position = start + 1;
+				continue;
+			}
+
+			token.type_length = current - token.type_offset;
+
+			size_t payload_offset = 0;
+			size_t payload_end = 0;
+			if (length_prefixed(data, token.type_offset - 1, end, payload_offset, payload_end))
+			{
+				if (payload_end + 2 > end || data.compare(payload_end, 2, L"];") != 0)
+				{
+					position = start + 1;
+					continue;
+				}
+
+				token.value_offset = payload_offset;
+				token.value_length = payload_end - payload_offset;
+				position = payload_end + 2;
+
+				return true;
+			}
+
+			++current;
+			while (current < end && (iswspace(data[current]) || data[current] == L'?'))
+			{
+				++current;
+			}
+
+			size_t finish = data.find(L"];", current);
+			if (finish == std::wstring::npos || finish + 2 > end)
+			{
+				position = end;
+				return false;
+			}
+
+			token.value_offset = current;
+			token.value_length = finish - current;
+			position = finish + 2;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool is_length_prefixed(const std::wstring& data, const field_token& token)
+	{
+		return data.compare(token.type_offset, token.type_length, LENGTH_PREFIXED_STRING) == 0;
+	}
+
+	long child_count(const std::wstring& data, const field_token& token)
+	{
+		if (data.compare(token.type_offset, token.type_length, convert_value_type(value_types::container_value)) != 0)
+		{
+			return 0;
+		}
+
+		return _wtol(data.substr(token.value_offset, token.value_length).c_str());
+	}
+
+	void append_xml_field(std::wstring& target, const wchar_t* name, const std::wstring& source)
+	{
+		fmt::format_to(std::back_inserter(target), L"<{}>", name);
+		value::append_xml_text(target, source);
+		fmt::format_to(std::back_inserter(target), L"</{}>", name);
+	}
+
+	void append_json_field(std::wstring& target, const wchar_t* name, const std::wstring& source)
+	{
+		fmt::format_to(std::back_inserter(target), L"{{\"{}\":\"", name);
+		value::append_json_text(target, source);
+		target.append(L"\"}");
+	}
+
 	value_container::value_container(void)
 		: _source_id(L""), _source_sub_id(L""), _target_id(L""), _target_sub_id(L""), _message_type(L"data_container"), _version(L"1.0.0.0"),
-		_parsed_data(true), _data_string(L"")
+		_parsed_data(true), _data_string(L""), _length_prefixed_strings(false), _arena_mode(false), _arena_block_size(16384), _arena(nullptr)
 	{
 	}
 
@@ -45,7 +304,12 @@ namespace container
 
 	value_container::value_container(const value_container& data_container, const bool& parse_only_header) : value_container()
 	{
-		deserialize(data_container.serialize(), parse_only_header);
+		copy_from(data_container, true);
+
+		if (!parse_only_header)
+		{
+			materialize();
+		}
 	}
 
 	value_container::value_container(std::shared_ptr<value_container> data_container, const bool& parse_only_header) : value_container()
@@ -55,7 +319,12 @@ namespace container
 			return;
 		}
 
-		deserialize(data_container->serialize(), parse_only_header);
+		copy_from(*data_container, true);
+
+		if (!parse_only_header)
+		{
+			materialize();
+		}
 	}
 
 	value_container::value_container(const std::wstring& message_type,
@@ -109,6 +378,37 @@ namespace container
 		_message_type = message_type;
 	}
 
+	void value_container::set_version(const std::wstring& version)
+	{
+		_version = version;
+	}
+
+	void value_container::set_source(const std::string& source_id, const std::string& source_sub_id)
+	{
+		set_source(converter::to_wstring(source_id), converter::to_wstring(source_sub_id));
+	}
+
+	void value_container::set_target(const std::string& target_id, const std::string& target_sub_id)
+	{
+		set_target(converter::to_wstring(target_id), converter::to_wstring(target_sub_id));
+	}
+
+	void value_container::set_message_type(const std::string& message_type)
+	{
+		set_message_type(converter::to_wstring(message_type));
+	}
+
+	void value_container::set_arena_mode(const bool& arena_mode, const size_t& block_size)
+	{
+		_arena_mode = arena_mode;
+		_arena_block_size = block_size;
+	}
+
+	void value_container::set_length_prefixed_strings(const bool& length_prefixed_strings)
+	{
+		_length_prefixed_strings = length_prefixed_strings;
+	}
+
 	std::wstring value_container::source_id(void) const
 	{
 		return _source_id;
@@ -134,11 +434,41 @@ namespace container
 		return _message_type;
 	}
 
+	std::wstring value_container::version(void) const
+	{
+		return _version;
+	}
+
+	bool value_container::arena_mode(void) const
+	{
+		return _arena_mode;
+	}
+
+	size_t value_container::arena_size(void) const
+	{
+		if (_arena == nullptr)
+		{
+			return 0;
+		}
+
+		return _arena->allocated_size();
+	}
+
+	bool value_container::length_prefixed_strings(void) const
+	{
+		return _length_prefixed_strings;
+	}
+
+	bool value_container::set_datas(const std::wstring& data_string)
+	{
+		return deserialize_values(data_string, true);
+	}
+
 	void value_container::set_units(const std::vector<std::shared_ptr<value>>& target_values)
 	{
 		if (!_parsed_data)
 		{
-			deserialize_values(_data_string, false);
+			materialize();
 		}
 
 		std::vector<std::shared_ptr<value>>::iterator target;
@@ -157,7 +487,9 @@ namespace container
 
 			_units.push_back(target_value);
 			target_value->set_parent(nullptr);
+			target_value->set_owner_index(_index);
 		}
+		_index.reset();
 	}
 
 	void value_container::swap_header(void)
@@ -175,35 +507,36 @@ namespace container
 	{
 		_parsed_data = true;
 		_data_string = L"";
+		_raw_data.reset();
+		_fields.clear();
 		_units.clear();
+		_index.reset();
+		_arena.reset();
 	}
 
 	std::shared_ptr<value_container> value_container::copy(const bool& containing_values)
 	{
-		std::shared_ptr<value_container> new_container = std::make_shared<value_container>(serialize(), !containing_values);
+		std::shared_ptr<value_container> new_container = std::make_shared<value_container>();
 		if (new_container == nullptr)
 		{
 			return nullptr;
 		}
 
-		if (!containing_values)
-		{
-			new_container->clear_value();
-		}
+		new_container->copy_from(*this, containing_values);
 
 		return new_container;
 	}
 
 	std::shared_ptr<value> value_container::add(const value& target_value)
 	{
-		return add(value::generate_value(target_value.name(), convert_value_type(target_value.type()), target_value.to_string()));
+		return add(value::generate_value(target_value.name(), convert_value_type(target_value.type()), target_value.to_string(false)));
 	}
 
 	std::shared_ptr<value> value_container::add(std::shared_ptr<value> target_value)
 	{
 		if (!_parsed_data)
 		{
-			deserialize_values(_data_string, false);
+			materialize();
 		}
 
 		std::vector<std::shared_ptr<value>>::iterator target;
@@ -219,7 +552,9 @@ namespace container
 		}
 
 		_units.push_back(target_value);
+		_index.reset();
 		target_value->set_parent(nullptr);
+		target_value->set_owner_index(_index);
 
 		return target_value;
 	}
@@ -228,7 +563,7 @@ namespace container
 	{
 		if (!_parsed_data)
 		{
-			deserialize_values(_data_string, false);
+			materialize();
 		}
 
 		std::vector<std::shared_ptr<value>>::iterator target;
@@ -247,13 +582,14 @@ namespace container
 
 			_units.erase(target);
 		}
+		_index.reset();
 	}
 
 	void value_container::remove(std::shared_ptr<value> target_value)
 	{
 		if (!_parsed_data)
 		{
-			deserialize_values(_data_string, false);
+			materialize();
 		}
 
 		std::vector<std::shared_ptr<value>>::iterator target;
@@ -269,46 +605,102 @@ namespace container
 		}
 
 		_units.erase(target);
+		_index.reset();
 	}
 
 	std::vector<std::shared_ptr<value>> value_container::value_array(const std::wstring& target_name)
 	{
-		if (!_parsed_data)
+		if (_parsed_data)
 		{
-			deserialize_values(_data_string, false);
+			return _index.collect(_units, target_name);
 		}
 
+		index_fields();
+
 		std::vector<std::shared_ptr<value>> result_list;
+		for (size_t field_index = 0; field_index < _fields.size(); ++field_index)
+		{
+			if (_data_string.compare(_fields[field_index].name_offset, _fields[field_index].name_length, target_name) != 0)
+			{
+				continue;
+			}
 
-		std::for_each(_units.begin(), _units.end(), [&target_name, &result_list](std::shared_ptr<value> source) {
-			if (source->name() == target_name)
+			std::shared_ptr<value> result = decode_field(field_index);
+			if (result != nullptr)
 			{
-				result_list.push_back(source);
+				result_list.push_back(result);
 			}
-			});
+		}
 
 		return result_list;
 	}
 
 	std::shared_ptr<value> value_container::get_value(const std::wstring& target_name, const unsigned int& index)
 	{
-		if (!_parsed_data)
+		std::shared_ptr<value> result = find_value(target_name, index);
+		if (result == nullptr)
 		{
-			deserialize_values(_data_string, false);
+			return std::make_shared<value>(target_name);
 		}
 
-		std::vector<std::shared_ptr<value>> result_list = value_array(target_name);
-		if (result_list.empty())
+		return result;
+	}
+
+	std::shared_ptr<value> value_container::find_value(const std::wstring& target_name, const unsigned int& index)
+	{
+		if (_parsed_data)
 		{
-			return std::make_shared<value>(target_name);
+			return _index.find(_units, target_name, index);
 		}
 
-		if (index >= result_list.size())
+		index_fields();
+
+		unsigned int matched = 0;
+		for (size_t field_index = 0; field_index < _fields.size(); ++field_index)
 		{
-			return std::make_shared<value>(target_name);
+			if (_data_string.compare(_fields[field_index].name_offset, _fields[field_index].name_length, target_name) != 0)
+			{
+				continue;
+			}
+
+			if (matched++ == index)
+			{
+				return decode_field(field_index);
+			}
 		}
 
-		return result_list[index];
+		return nullptr;
+	}
+
+	size_t value_container::value_count(const std::wstring& target_name)
+	{
+		if (_parsed_data)
+		{
+			return _index.count(_units, target_name);
+		}
+
+		index_fields();
+
+		size_t matched = 0;
+		for (auto& field : _fields)
+		{
+			if (_data_string.compare(field.name_offset, field.name_length, target_name) == 0)
+			{
+				++matched;
+			}
+		}
+
+		return matched;
+	}
+
+	std::shared_ptr<value> value_container::get_value(const std::string& target_name, const unsigned int& index)
+	{
+		return get_value(converter::to_wstring(target_name), index);
+	}
+
+	std::shared_ptr<value> value_container::find_value(const std::string& target_name, const unsigned int& index)
+	{
+		return find_value(converter::to_wstring(target_name), index);
 	}
 
 	void value_container::initialize(void)
@@ -325,37 +717,37 @@ namespace container
 
 	std::wstring value_container::serialize(void) const
 	{
-		fmt::wmemory_buffer result;
-		result.clear();
+		return serialize_header() + datas();
+	}
 
-		// header
-		fmt::format_to(std::back_inserter(result), L"@header={}", L"{");
-		if (_message_type != L"data_container")
+	std::vector<unsigned char> value_container::serialize_array(void) const
+	{
+		if (!_parsed_data && _raw_data != nullptr)
 		{
-			fmt::format_to(std::back_inserter(result), L"[{},{}];", TARGET_ID, _target_id);
-			fmt::format_to(std::back_inserter(result), L"[{},{}];", TARGET_SUB_ID, _target_sub_id);
-			fmt::format_to(std::back_inserter(result), L"[{},{}];", SOURCE_ID, _source_id);
-			fmt::format_to(std::back_inserter(result), L"[{},{}];", SOURCE_SUB_ID, _source_sub_id);
+			std::vector<unsigned char> result = converter::to_array(serialize_header());
+			result.insert(result.end(), _raw_data->begin(), _raw_data->end());
+
+			return result;
 		}
-		fmt::format_to(std::back_inserter(result), L"[{},{}];", MESSAGE_TYPE, _message_type);
-		fmt::format_to(std::back_inserter(result), L"[{},{}];", MESSAGE_VERSION, _version);
-		fmt::format_to(std::back_inserter(result), L"{}", L"};");
 
 		if (!_parsed_data)
 		{
-			fmt::format_to(std::back_inserter(result), L"{}", _data_string);
-
-			return result.data();
+			return converter::to_array(serialize());
 		}
 
-		fmt::format_to(std::back_inserter(result), L"{}", datas());
+		// each top-level value keeps its serialized bytes until it changes, so an unchanged tree is only spliced together
+		const std::string data_begin = "@data={";
+		const std::string data_end = "};";
 
-		return result.data();
-	}
+		std::vector<unsigned char> result = converter::to_array(serialize_header());
+		result.insert(result.end(), data_begin.begin(), data_begin.end());
+		for (auto& unit : _units)
+		{
+			unit->append_serialized(result, _length_prefixed_strings);
+		}
+		result.insert(result.end(), data_end.begin(), data_end.end());
 
-	std::vector<unsigned char> value_container::serialize_array(void) const
-	{
-		return converter::to_array(serialize());
+		return result;
 	}
 
 	bool value_container::deserialize(const std::wstring& data_string, const bool& parse_only_header)
@@ -367,8 +759,8 @@ namespace container
 			return false;
 		}
 
-		std::wregex newlines_re(L"\\r\\n?|\\n");
-		std::wstring removed_newline = std::regex_replace(data_string, newlines_re, L"");
+		std::wstring removed_newline = data_string;
+		remove_newlines(removed_newline);
 
 		std::wregex full_condition(L"@header=[\\s?]*\\{[\\s?]*(.*?)[\\s?]*\\};");
 		std::wsregex_iterator full_iter(removed_newline.begin(), removed_newline.end(), full_condition);
@@ -399,38 +791,92 @@ namespace container
 
 	bool value_container::deserialize(const std::vector<unsigned char>& data_array, const bool& parse_only_header)
 	{
-		return deserialize(converter::to_wstring(data_array), parse_only_header);
+		return deserialize(data_array.data(), data_array.size(), parse_only_header);
+	}
+
+	bool value_container::deserialize(const unsigned char* data, const size_t& size, const bool& parse_only_header)
+	{
+		if (data == nullptr || size == 0)
+		{
+			initialize();
+
+			return false;
+		}
+
+		if (!parse_only_header)
+		{
+			return deserialize(converter::to_wstring(data, size), parse_only_header);
+		}
+
+		// only the header is converted; the @data section stays as received until a field is accessed
+		const unsigned char* data_end = data + size;
+		const std::string marker = "@data=";
+		const unsigned char* start = std::search(data, data_end, marker.begin(), marker.end());
+		while (start != data_end)
+		{
+			const unsigned char* position = start + marker.size();
+			while (position != data_end && (isspace(*position) || *position == '?'))
+			{
+				++position;
+			}
+
+			if (position != data_end && *position == '{')
+			{
+				break;
+			}
+
+			start = std::search(start + 1, data_end, marker.begin(), marker.end());
+		}
+
+		if (start == data_end)
+		{
+			return deserialize(converter::to_wstring(data, size), parse_only_header);
+		}
+
+		size_t end = find_section_end(byte_view{ data, size }, start - data);
+		if (end == std::wstring::npos)
+		{
+			return deserialize(converter::to_wstring(data, size), parse_only_header);
+		}
+
+		deserialize(converter::to_wstring(data, start - data), true);
+
+		std::vector<unsigned char> raw_data(start, data + end + 2);
+		remove_newlines(raw_data);
+
+		_raw_data = std::make_shared<const std::vector<unsigned char>>(std::move(raw_data));
+		_parsed_data = false;
+
+		return true;
 	}
 
 	const std::wstring value_container::to_xml(void)
 	{
 		if (!_parsed_data)
 		{
-			deserialize_values(_data_string, false);
+			materialize();
 		}
 
 		std::wstring result;
 
-		fmt::format_to(std::back_inserter(result), L"{}", L"<container>");
-		fmt::format_to(std::back_inserter(result), L"{}", L"<header>");
+		result.append(L"<container><header>");
 		if (_message_type != L"data_container")
 		{
-			fmt::format_to(std::back_inserter(result), L"<target_id>{}</target_id>", _target_id);
-			fmt::format_to(std::back_inserter(result), L"<target_sub_id>{}</target_sub_id>", _target_sub_id);
-			fmt::format_to(std::back_inserter(result), L"<source_id>{}</source_id>", _source_id);
-			fmt::format_to(std::back_inserter(result), L"<source_sub_id>{}</source_sub_id>", _source_sub_id);
+			append_xml_field(result, L"target_id", _target_id);
+			append_xml_field(result, L"target_sub_id", _target_sub_id);
+			append_xml_field(result, L"source_id", _source_id);
+			append_xml_field(result, L"source_sub_id", _source_sub_id);
 		}
-		fmt::format_to(std::back_inserter(result), L"<message_type>{}</message_type>", _message_type);
-		fmt::format_to(std::back_inserter(result), L"<version>{}</version>", _version);
-		fmt::format_to(std::back_inserter(result), L"{}", L"</header>");
+		append_xml_field(result, L"message_type", _message_type);
+		append_xml_field(result, L"version", _version);
+		result.append(L"</header>");
 
-		fmt::format_to(std::back_inserter(result), L"{}", L"<values>");
+		result.append(L"<values>");
 		for (auto& unit : _units)
 		{
-			fmt::format_to(std::back_inserter(result), L"{}", unit->to_xml());
+			unit->append_xml(result);
 		}
-		fmt::format_to(std::back_inserter(result), L"{}", L"</values>");
-		fmt::format_to(std::back_inserter(result), L"{}", L"</container>");
+		result.append(L"</values></container>");
 
 		return result;
 	}
@@ -439,43 +885,65 @@ namespace container
 	{
 		if (!_parsed_data)
 		{
-			deserialize_values(_data_string, false);
+			materialize();
 		}
 
 		std::wstring result;
 
-		fmt::format_to(std::back_inserter(result), L"{}", L"{");
-		fmt::format_to(std::back_inserter(result), L"{}", L"\"header\":[");
+		result.append(L"{\"header\":[");
 		if (_message_type != L"data_container")
 		{
-			fmt::format_to(std::back_inserter(result), L"{}\"target_id\":\"{}\"{},", L"{", _target_id, L"}");
-			fmt::format_to(std::back_inserter(result), L"{}\"target_sub_id\":\"{}\"{},", L"{", _target_sub_id, L"}");
-			fmt::format_to(std::back_inserter(result), L"{}\"source_id\":\"{}\"{},", L"{", _source_id, L"}");
-			fmt::format_to(std::back_inserter(result), L"{}\"source_sub_id\":\"{}\"{},", L"{", _source_sub_id, L"}");
+			append_json_field(result, L"target_id", _target_id);
+			result.push_back(L',');
+			append_json_field(result, L"target_sub_id", _target_sub_id);
+			result.push_back(L',');
+			append_json_field(result, L"source_id", _source_id);
+			result.push_back(L',');
+			append_json_field(result, L"source_sub_id", _source_sub_id);
+			result.push_back(L',');
 		}
-		fmt::format_to(std::back_inserter(result), L"{}\"message_type\":\"{}\"{}", L"{", _message_type, L"}");
-		fmt::format_to(std::back_inserter(result), L",{}\"version\":\"{}\"{}", L"{", _version, L"}");
-		fmt::format_to(std::back_inserter(result), L"{}", L"]");
-
-		fmt::format_to(std::back_inserter(result), L",{}", L"\"values\":[");
+		append_json_field(result, L"message_type", _message_type);
+		result.push_back(L',');
+		append_json_field(result, L"version", _version);
+		result.append(L"],\"values\":[");
 
 		bool first = true;
 		for (auto& unit : _units)
 		{
-			fmt::format_to(std::back_inserter(result), first ? L"{}" : L",{}", unit->to_json());
+			if (!first)
+			{
+				result.push_back(L',');
+			}
+
+			unit->append_json(result);
 			first = false;
 		}
-		fmt::format_to(std::back_inserter(result), L"{}", L"]");
-		fmt::format_to(std::back_inserter(result), L"{}", L"}");
+		result.append(L"]}");
 
-		return result;;
+		return result;
+	}
+
+	bool value_container::from_json(const std::wstring& json_string)
+	{
+		initialize();
+
+		return json_parser::parse(json_string, *this);
 	}
 
 	std::wstring value_container::datas(void) const
 	{
+		if (!_parsed_data && _raw_data != nullptr)
+		{
+			return converter::to_wstring(*_raw_data);
+		}
+
 		if (!_parsed_data)
 		{
-			return _data_string;
+			bool decoded = std::any_of(_fields.begin(), _fields.end(), [](const field_offset& field) { return field.decoded != nullptr; });
+			if (!decoded)
+			{
+				return _data_string;
+			}
 		}
 
 		fmt::wmemory_buffer result;
@@ -483,23 +951,46 @@ namespace container
 
 		// data
 		fmt::format_to(std::back_inserter(result), L"@data={}", L"{");
-		for (auto& unit : _units)
+		if (!_parsed_data)
 		{
-			fmt::format_to(std::back_inserter(result), L"{}", unit->serialize());
+			// untouched fields are copied verbatim from the received data
+			for (auto& field : _fields)
+			{
+				if (field.decoded != nullptr)
+				{
+					std::wstring fragment;
+					field.decoded->append_serialized(fragment, _length_prefixed_strings);
+					result.append(fragment.data(), fragment.data() + fragment.size());
+					continue;
+				}
+
+				result.append(_data_string.data() + field.offset, _data_string.data() + field.offset + field.length);
+			}
+		}
+		else
+		{
+			for (auto& unit : _units)
+			{
+				std::wstring fragment;
+				unit->append_serialized(fragment, _length_prefixed_strings);
+				result.append(fragment.data(), fragment.data() + fragment.size());
+			}
 		}
 		fmt::format_to(std::back_inserter(result), L"{}", L"};");
 
-		return result.data();
+		return std::wstring(result.data(), result.size());
 	}
 
 	void value_container::load_packet(const std::wstring& file_path)
 	{
-		deserialize(converter::to_wstring(file_handler::load(file_path)));
+		// the header is parsed straight from the mapped pages and only the @data section is copied out
+		file_mapping mapping(file_path);
+		deserialize(mapping.data(), mapping.size());
 	}
 
 	void value_container::save_packet(const std::wstring& file_path)
 	{
-		file_handler::save(file_path, converter::to_array(serialize()));
+		file_handler::save(file_path, serialize_array());
 	}
 
 	std::vector<std::shared_ptr<value>> value_container::operator[](const std::wstring& key)
@@ -593,15 +1084,32 @@ namespace container
 
 	bool value_container::deserialize_values(const std::wstring& data, const bool& parse_only_header)
 	{
-		if (_units.size() > 0)
+		_units.clear();
+		_index.reset();
+		_fields.clear();
+		_raw_data.reset();
+		_arena.reset();
+
+		size_t start = data.find(L"@data=");
+		size_t end = std::wstring::npos;
+		while (start != std::wstring::npos)
 		{
-			_units.clear();
+			size_t position = start + 6;
+			while (position < data.size() && (iswspace(data[position]) || data[position] == L'?'))
+			{
+				++position;
+			}
+
+			if (position < data.size() && data[position] == L'{')
+			{
+				end = find_section_end(data, position + 1);
+				break;
+			}
+
+			start = data.find(L"@data=", start + 6);
 		}
 
-		std::wregex full_condition(L"@data=[\\s?]*\\{[\\s?]*(.*?)[\\s?]*\\};");
-		std::wsregex_iterator full_iter(data.begin(), data.end(), full_condition);
-		std::wsregex_iterator full_end;
-		if (full_iter == full_end)
+		if (start == std::wstring::npos || end == std::wstring::npos)
 		{
 			_data_string = L"";
 			_parsed_data = true;
@@ -609,65 +1117,232 @@ namespace container
 			return false;
 		}
 
-		std::wstring regex_temp = (*full_iter)[0].str();
-		
+		_data_string = data.substr(start, end + 2 - start);
+		_parsed_data = false;
+
 		if (parse_only_header)
 		{
-			_data_string = regex_temp;
-			_parsed_data = false;
-
 			return true;
 		}
 
+		materialize();
+
+		return true;
+	}
+
+	void value_container::materialize(void)
+	{
+		if (_parsed_data)
+		{
+			return;
+		}
+
+		index_fields();
+
+		std::vector<std::shared_ptr<value>> units;
+		units.reserve(_fields.size());
+		for (size_t field_index = 0; field_index < _fields.size(); ++field_index)
+		{
+			std::shared_ptr<value> unit = decode_field(field_index);
+			if (unit != nullptr)
+			{
+				units.push_back(unit);
+			}
+		}
+
+		_fields.clear();
 		_data_string = L"";
 		_parsed_data = true;
 
-		std::wregex regex_condition(L"\\[(\\w+),[\\s?]*(\\w+),[\\s?]*(.*?)\\];");
-		std::wsregex_iterator start(regex_temp.begin(), regex_temp.end(), regex_condition);
-		std::wsregex_iterator end;
+		_units.swap(units);
+		_index.reset();
+	}
 
-		std::vector<std::shared_ptr<value>> temp_list;
-		while (start != end)
+	void value_container::index_fields(void)
+	{
+		if (_parsed_data || !_fields.empty())
 		{
-			temp_list.push_back(value::generate_value((*start)[1], (*start)[2], (*start)[3]));
+			return;
+		}
 
-			start++;
+		if (_raw_data != nullptr)
+		{
+			_data_string = converter::to_wstring(*_raw_data);
+			_raw_data.reset();
 		}
 
-		std::shared_ptr<value> container = nullptr;
-		std::vector<std::shared_ptr<value>>::iterator iterator;
-		for (iterator = temp_list.begin(); iterator != temp_list.end(); ++iterator)
+		size_t position = 0;
+		field_token token;
+		while (next_field(_data_string, _data_string.size(), position, token))
 		{
-			if (container == nullptr)
+			field_offset field{ token.offset, 0, token.name_offset, token.name_length, nullptr };
+
+			// a received length-prefixed string keeps that encoding when the container is serialized again
+			_length_prefixed_strings = _length_prefixed_strings || is_length_prefixed(_data_string, token);
+
+			std::vector<long> remained;
+			long count = child_count(_data_string, token);
+			if (count > 0)
+			{
+				remained.push_back(count);
+			}
+
+			while (!remained.empty() && next_field(_data_string, _data_string.size(), position, token))
 			{
-				add(*iterator);
+				--remained.back();
 
-				if ((*iterator)->is_container() != true || (*iterator)->to_long() == 0)
+				_length_prefixed_strings = _length_prefixed_strings || is_length_prefixed(_data_string, token);
+				count = child_count(_data_string, token);
+				if (count > 0)
 				{
-					continue;
+					remained.push_back(count);
 				}
 
-				container = *iterator;
-
-				continue;
+				while (!remained.empty() && remained.back() == 0)
+				{
+					remained.pop_back();
+				}
 			}
 
-			container->add(*iterator, false);
+			field.length = position - field.offset;
+			_fields.push_back(field);
+		}
+	}
+
+	std::shared_ptr<value> value_container::decode_field(const size_t& field_index)
+	{
+		if (field_index >= _fields.size())
+		{
+			return nullptr;
+		}
+
+		field_offset& field = _fields[field_index];
+		if (field.decoded != nullptr)
+		{
+			return field.decoded;
+		}
+
+		if (_arena_mode && _arena == nullptr)
+		{
+			_arena = std::make_shared<value_arena>((std::max)(_arena_block_size, _data_string.size() * sizeof(wchar_t)));
+		}
 
-			if ((*iterator)->is_container() == true)
+		std::vector<std::shared_ptr<value>> values = parse_values(field.offset, field.offset + field.length);
+		if (values.empty())
+		{
+			return nullptr;
+		}
+
+		field.decoded = values[0];
+		field.decoded->set_parent(nullptr);
+		field.decoded->set_owner_index(_index);
+
+		return field.decoded;
+	}
+
+	std::vector<std::shared_ptr<value>> value_container::parse_values(const size_t& offset, const size_t& end)
+	{
+		std::vector<std::shared_ptr<value>> result_list;
+
+		size_t position = offset;
+		field_token token;
+		std::shared_ptr<value> container = nullptr;
+		while (next_field(_data_string, end, position, token))
+		{
+			std::shared_ptr<value> current = value::generate_value(_data_string.substr(token.name_offset, token.name_length),
+				_data_string.substr(token.type_offset, token.type_length), _data_string.substr(token.value_offset, token.value_length), _arena);
+
+			if (container == nullptr)
+			{
+				result_list.push_back(current);
+			}
+			else
 			{
-				container = *iterator;
+				container->add(current, false);
+			}
+
+			if (current->is_container() && current->to_long() > 0)
+			{
+				container = current;
 
 				continue;
 			}
 
-			while (container != nullptr && container->to_long() == container->child_count())
+			while (container != nullptr && container->to_long() == static_cast<long>(container->child_count()))
 			{
 				container = container->parent();
 			}
 		}
 
-		return true;
+		return result_list;
+	}
+
+	std::wstring value_container::serialize_header(void) const
+	{
+		fmt::wmemory_buffer result;
+		result.clear();
+
+		// header
+		fmt::format_to(std::back_inserter(result), L"@header={}", L"{");
+		if (_message_type != L"data_container")
+		{
+			fmt::format_to(std::back_inserter(result), L"[{},{}];", TARGET_ID, _target_id);
+			fmt::format_to(std::back_inserter(result), L"[{},{}];", TARGET_SUB_ID, _target_sub_id);
+			fmt::format_to(std::back_inserter(result), L"[{},{}];", SOURCE_ID, _source_id);
+			fmt::format_to(std::back_inserter(result), L"[{},{}];", SOURCE_SUB_ID, _source_sub_id);
+		}
+		fmt::format_to(std::back_inserter(result), L"[{},{}];", MESSAGE_TYPE, _message_type);
+		fmt::format_to(std::back_inserter(result), L"[{},{}];", MESSAGE_VERSION, _version);
+		fmt::format_to(std::back_inserter(result), L"{}", L"};");
+
+		return std::wstring(result.data(), result.size());
+	}
+
+	void value_container::copy_from(const value_container& source, const bool& containing_values)
+	{
+		_source_id = source._source_id;
+		_source_sub_id = source._source_sub_id;
+		_target_id = source._target_id;
+		_target_sub_id = source._target_sub_id;
+		_message_type = source._message_type;
+		_version = source._version;
+		_arena_mode = source._arena_mode;
+		_arena_block_size = source._arena_block_size;
+		_length_prefixed_strings = source._length_prefixed_strings;
+
+		clear_value();
+
+		if (!containing_values)
+		{
+			return;
+		}
+
+		if (_arena_mode)
+		{
+			_arena = std::make_shared<value_arena>(_arena_block_size);
+		}
+
+		// received bytes are never modified in place, so copies share them until a field is accessed
+		_parsed_data = source._parsed_data;
+		_raw_data = source._raw_data;
+		_data_string = source._data_string;
+		_fields = source._fields;
+		for (auto& field : _fields)
+		{
+			if (field.decoded != nullptr)
+			{
+				field.decoded = field.decoded->copy(_arena);
+				field.decoded->set_owner_index(_index);
+			}
+		}
+
+		_units.reserve(source._units.size());
+		for (auto& unit : source._units)
+		{
+			std::shared_ptr<value> copied = unit->copy(_arena);
+			copied->set_owner_index(_index);
+			_units.push_back(copied);
+		}
 	}
 
 	void value_container::parsing(const std::wstring& source_name, const std::wstring& target_name, const std::wstring& target_value, std::wstring& target_variable)
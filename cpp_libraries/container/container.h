@@ -30,7 +30,14 @@ namespace container
 		void set_source(const std::wstring& source_id, const std::wstring& source_sub_id);
 		void set_target(const std::wstring& target_id, const std::wstring& target_sub_id = L"");
 		void set_message_type(const std::wstring& message_type);
+		void set_version(const std::wstring& version);
+		void set_source(const std::string& source_id, const std::string& source_sub_id);
+		void set_target(const std::string& target_id, const std::string& target_sub_id = "");
+		void set_message_type(const std::string& message_type);
+		bool set_datas(const std::wstring& data_string);
 		void set_units(const std::vector<std::shared_ptr<value>>& target_values);
+		void set_arena_mode(const bool& arena_mode, const size_t& block_size = 16384);
+		void set_length_prefixed_strings(const bool& length_prefixed_strings);
 
 	public:
 		void swap_header(void);
@@ -43,6 +50,10 @@ namespace container
 		std::wstring target_id(void) const;
 		std::wstring target_sub_id(void) const;
 		std::wstring message_type(void) const;
+		std::wstring version(void) const;
+		bool arena_mode(void) const;
+		size_t arena_size(void) const;
+		bool length_prefixed_strings(void) const;
 
 	public:
 		std::shared_ptr<value> add(const value& target_value);
@@ -51,19 +62,26 @@ namespace container
 		void remove(std::shared_ptr<value> target_value);
 		std::vector<std::shared_ptr<value>> value_array(const std::wstring& target_name);
 		std::shared_ptr<value> get_value(const std::wstring& target_name, const unsigned int& index = 0);
+		std::shared_ptr<value> find_value(const std::wstring& target_name, const unsigned int& index = 0);
+		size_t value_count(const std::wstring& target_name);
+		std::shared_ptr<value> get_value(const std::string& target_name, const unsigned int& index = 0);
+		std::shared_ptr<value> find_value(const std::string& target_name, const unsigned int& index = 0);
 
 	public:
 		void initialize(void);
 		
 	public:
 		std::wstring serialize(void) const;
+		std::wstring serialize_header(void) const;
 		std::vector<unsigned char> serialize_array(void) const;
 		bool deserialize(const std::wstring& data_string, const bool& parse_only_header = true);
 		bool deserialize(const std::vector<unsigned char>& data_array, const bool& parse_only_header = true);
+		bool deserialize(const unsigned char* data, const size_t& size, const bool& parse_only_header = true);
 
 	public:
 		const std::wstring to_xml(void);
 		const std::wstring to_json(void);
+		bool from_json(const std::wstring& json_string);
 
 	public:
 		std::wstring datas(void) const;
@@ -92,11 +110,36 @@ namespace container
 
 	protected:
 		bool deserialize_values(const std::wstring& data, const bool& parse_only_header = true);
+		void materialize(void);
+		void index_fields(void);
+		std::shared_ptr<value> decode_field(const size_t& field_index);
+		std::vector<std::shared_ptr<value>> parse_values(const size_t& offset, const size_t& end);
 		void parsing(const std::wstring& source_name, const std::wstring& target_name, const std::wstring& target_value, std::wstring& target_variable);
+		void copy_from(const value_container& source, const bool& containing_values);
+
+	private:
+		struct field_offset
+		{
+			size_t offset;
+			size_t length;
+			size_t name_offset;
+			size_t name_length;
+			std::shared_ptr<value> decoded;
+		};
 
 	private:
 		bool _parsed_data;
 		std::wstring _data_string;
+		std::shared_ptr<const std::vector<unsigned char>> _raw_data;
+		std::vector<field_offset> _fields;
+
+	private:
+		bool _length_prefixed_strings;
+
+	private:
+		bool _arena_mode;
+		size_t _arena_block_size;
+		std::shared_ptr<value_arena> _arena;
 
 	private:
 		std::wstring _source_id;
@@ -106,5 +149,6 @@ namespace container
 		std::wstring _message_type;
 		std::wstring _version;
 		std::vector<std::shared_ptr<value>> _units;
+		value_index _index;
 	};
 }
\ No newline at end of file
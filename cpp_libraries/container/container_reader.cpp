@@ -0,0 +1,361 @@
+#include "container_reader.h"
+
+#include "converting.h"
+
+#include "values/string_value.h"
+
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+namespace container
+{
+	using namespace converting;
+
+	container_reader::container_reader(const std::function<size_t(unsigned char*, const size_t&)>& source, const size_t& chunk_size)
+		: _opened(false), _completed(false), _end_of_source(false), _chunk_size(chunk_size), _position(0), _source(source),
+		_header(nullptr), _event(stream_events::scalar), _name(L""), _type_code(L""), _type(value_types::null_value), _data(""), _count(0)
+	{
+	}
+
+	container_reader::container_reader(const std::wstring& file_path, const size_t& chunk_size)
+		: container_reader(std::function<size_t(unsigned char*, const size_t&)>(), chunk_size)
+	{
+		std::shared_ptr<std::ifstream> file = std::make_shared<std::ifstream>(std::filesystem::path(file_path), std::ios::binary);
+		if (!file->is_open())
+		{
+			_end_of_source = true;
+			return;
+		}
+
+		_source = [file](unsigned char* target, const size_t& size) -> size_t
+		{
+			file->read(reinterpret_cast<char*>(target), size);
+
+			return static_cast<size_t>(file->gcount());
+		};
+	}
+
+	container_reader::container_reader(const std::vector<unsigned char>& data)
+		: container_reader(std::function<size_t(unsigned char*, const size_t&)>(), data.size())
+	{
+		_buffer = data;
+		_end_of_source = true;
+	}
+
+	container_reader::~container_reader(void)
+	{
+	}
+
+	bool container_reader::next(void)
+	{
+		if (!_opened)
+		{
+			_opened = true;
+			if (!open())
+			{
+				return false;
+			}
+		}
+
+		if (_completed)
+		{
+			return false;
+		}
+
+		// a container ends as soon as the number of children announced in its record has been read
+		if (!_levels.empty() && _levels.back().remained <= 0)
+		{
+			_event = stream_events::end_container;
+			_name = _levels.back().name;
+			_count = 0;
+			_levels.pop_back();
+
+			return true;
+		}
+
+		return read_field();
+	}
+
+	bool container_reader::parse(const std::function<void(const std::wstring&, const long&)>& begin_container,
+		const std::function<void(std::shared_ptr<value>)>& scalar,
+		const std::function<void(const std::wstring&)>& end_container)
+	{
+		while (next())
+		{
+			switch (_event)
+			{
+			case stream_events::begin_container: if (begin_container != nullptr) { begin_container(_name, _count); } break;
+			case stream_events::scalar: if (scalar != nullptr) { scalar(to_value()); } break;
+			case stream_events::end_container: if (end_container != nullptr) { end_container(_name); } break;
+			}
+		}
+
+		return _completed;
+	}
+
+	std::shared_ptr<value_container> container_reader::header(void) const
+	{
+		return _header;
+	}
+
+	stream_events container_reader::event(void) const
+	{
+		return _event;
+	}
+
+	const std::wstring& container_reader::name(void) const
+	{
+		return _name;
+	}
+
+	value_types container_reader::type(void) const
+	{
+		return _type;
+	}
+
+	long container_reader::count(void) const
+	{
+		return _count;
+	}
+
+	size_t container_reader::depth(void) const
+	{
+		return _levels.size();
+	}
+
+	bool container_reader::completed(void) const
+	{
+		return _completed;
+	}
+
+	std::shared_ptr<value> container_reader::to_value(void) const
+	{
+		if (_event != stream_events::scalar)
+		{
+			return nullptr;
+		}
+
+		if (_type_code == LENGTH_PREFIXED_STRING)
+		{
+			return std::make_shared<string_value>(_name, _data);
+		}
+
+		if (_type == value_types::string_value)
+		{
+			return std::make_shared<string_value>(_name, string_value::unescape(_data.data(), _data.size()));
+		}
+
+		return value::generate_value(_name, _type_code, converter::to_wstring(_data));
+	}
+
+	bool container_reader::open(void)
+	{
+		size_t marker = find("@data=", 0);
+		if (marker == std::string::npos)
+		{
+			return false;
+		}
+
+		if (marker == 0)
+		{
+			_header = std::make_shared<value_container>();
+		}
+		else
+		{
+			_header = std::make_shared<value_container>(std::vector<unsigned char>(_buffer.begin() + _position, _buffer.begin() + _position + marker));
+		}
+
+		_position += marker + 6;
+		skip_spaces();
+
+		if (!ensure(1) || _buffer[_position] != '{')
+		{
+			return false;
+		}
+
+		++_position;
+
+		return true;
+	}
+
+	bool container_reader::read_field(void)
+	{
+		skip_spaces();
+
+		if (!ensure(2))
+		{
+			return false;
+		}
+
+		if (_buffer[_position] == '}' && _buffer[_position + 1] == ';')
+		{
+			_position += 2;
+			_completed = _levels.empty();
+
+			return false;
+		}
+
+		if (_buffer[_position] != '[')
+		{
+			return false;
+		}
+
+		size_t name_end = find(",", 1);
+		if (name_end == std::string::npos)
+		{
+			return false;
+		}
+
+		size_t type_end = find(",", name_end + 1);
+		if (type_end == std::string::npos)
+		{
+			return false;
+		}
+
+		const char* source = reinterpret_cast<const char*>(_buffer.data() + _position);
+		_name = converter::to_wstring(std::string(source + 1, source + name_end));
+		_type_code = converter::to_wstring(std::string(source + name_end + 1, source + type_end));
+		_type = convert_value_type(_type_code);
+
+		if (_type_code == LENGTH_PREFIXED_STRING)
+		{
+			// the payload is read by its byte length, so it may hold anything including "];"
+			size_t colon = find(":", type_end + 1);
+			if (colon == std::string::npos)
+			{
+				return false;
+			}
+
+			source = reinterpret_cast<const char*>(_buffer.data() + _position);
+			size_t length = std::strtoull(std::string(source + type_end + 1, source + colon).c_str(), nullptr, 10);
+			if (!ensure(colon + 1 + length + 2))
+			{
+				return false;
+			}
+
+			source = reinterpret_cast<const char*>(_buffer.data() + _position);
+			if (source[colon + 1 + length] != ']' || source[colon + 2 + length] != ';')
+			{
+				return false;
+			}
+
+			_data.assign(source + colon + 1, length);
+			_position += colon + 1 + length + 2;
+		}
+		else
+		{
+			size_t finish = find("];", type_end + 1);
+			if (finish == std::string::npos)
+			{
+				return false;
+			}
+
+			source = reinterpret_cast<const char*>(_buffer.data() + _position);
+			_data.assign(source + type_end + 1, source + finish);
+			_data.erase(std::remove_if(_data.begin(), _data.end(), [](const char& character) { return character == '\r' || character == '\n'; }), _data.end());
+			_position += finish + 2;
+		}
+
+		if (!_levels.empty())
+		{
+			--_levels.back().remained;
+		}
+
+		if (_type == value_types::container_value)
+		{
+			_event = stream_events::begin_container;
+			_count = std::strtol(_data.c_str(), nullptr, 10);
+			_levels.push_back({ _name, _count });
+
+			return true;
+		}
+
+		_event = stream_events::scalar;
+		_count = 0;
+
+		return true;
+	}
+
+	bool container_reader::fill(void)
+	{
+		if (_end_of_source || _source == nullptr)
+		{
+			_end_of_source = true;
+
+			return false;
+		}
+
+		// consumed bytes are dropped once they add up to a chunk, which keeps the buffer bounded
+		if (_position >= _chunk_size)
+		{
+			_buffer.erase(_buffer.begin(), _buffer.begin() + _position);
+			_position = 0;
+		}
+
+		size_t offset = _buffer.size();
+		_buffer.resize(offset + _chunk_size);
+
+		size_t read = _source(_buffer.data() + offset, _chunk_size);
+		_buffer.resize(offset + read);
+		if (read == 0)
+		{
+			_end_of_source = true;
+
+			return false;
+		}
+
+		return true;
+	}
+
+	bool container_reader::ensure(const size_t& size)
+	{
+		while (_buffer.size() - _position < size)
+		{
+			if (!fill())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	size_t container_reader::find(const std::string& token, const size_t& offset)
+	{
+		size_t from = offset;
+		while (true)
+		{
+			if (_position + from < _buffer.size())
+			{
+				auto found = std::search(_buffer.begin() + _position + from, _buffer.end(), token.begin(), token.end());
+				if (found != _buffer.end())
+				{
+					return static_cast<size_t>(found - _buffer.begin()) - _position;
+				}
+
+				size_t available = _buffer.size() - _position;
+				from = (std::max)(from, available >= token.size() ? available - token.size() + 1 : 0);
+			}
+
+			if (!fill())
+			{
+				return std::string::npos;
+			}
+		}
+	}
+
+	void container_reader::skip_spaces(void)
+	{
+		while (ensure(1))
+		{
+			unsigned char character = _buffer[_position];
+			if (character != ' ' && character != '\t' && character != '\r' && character != '\n' && character != '?')
+			{
+				return;
+			}
+
+			++_position;
+		}
+	}
+}
\ No newline at end of file
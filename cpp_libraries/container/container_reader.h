@@ -0,0 +1,77 @@
+#pragma once
+
+#include "container.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace container
+{
+	enum class stream_events
+	{
+		begin_container,
+		scalar,
+		end_container
+	};
+
+	class container_reader
+	{
+	public:
+		container_reader(const std::function<size_t(unsigned char*, const size_t&)>& source, const size_t& chunk_size = 65536);
+		container_reader(const std::wstring& file_path, const size_t& chunk_size = 65536);
+		container_reader(const std::vector<unsigned char>& data);
+		~container_reader(void);
+
+	public:
+		bool next(void);
+		bool parse(const std::function<void(const std::wstring&, const long&)>& begin_container,
+			const std::function<void(std::shared_ptr<value>)>& scalar,
+			const std::function<void(const std::wstring&)>& end_container);
+
+	public:
+		std::shared_ptr<value_container> header(void) const;
+		stream_events event(void) const;
+		const std::wstring& name(void) const;
+		value_types type(void) const;
+		long count(void) const;
+		size_t depth(void) const;
+		bool completed(void) const;
+		std::shared_ptr<value> to_value(void) const;
+
+	protected:
+		bool open(void);
+		bool read_field(void);
+		bool fill(void);
+		bool ensure(const size_t& size);
+		size_t find(const std::string& token, const size_t& offset);
+		void skip_spaces(void);
+
+	private:
+		struct container_level
+		{
+			std::wstring name;
+			long remained;
+		};
+
+	private:
+		bool _opened;
+		bool _completed;
+		bool _end_of_source;
+		size_t _chunk_size;
+		size_t _position;
+		std::vector<unsigned char> _buffer;
+		std::function<size_t(unsigned char*, const size_t&)> _source;
+
+	private:
+		std::shared_ptr<value_container> _header;
+		std::vector<container_level> _levels;
+		stream_events _event;
+		std::wstring _name;
+		std::wstring _type_code;
+		value_types _type;
+		std::string _data;
+		long _count;
+	};
+}
@@ -0,0 +1,251 @@
+#include "container_writer.h"
+
+#include "converting.h"
+
+#include "values/string_value.h"
+
+#include "fmt/format.h"
+
+namespace container
+{
+	using namespace converting;
+
+	container_writer::container_writer(const std::function<void(const std::vector<unsigned char>&)>& flush, const size_t& flush_size,
+		const bool& length_prefixed_strings)
+		: _flush_size(flush_size), _written(0), _length_prefixed_strings(length_prefixed_strings), _flush(flush)
+	{
+		_buffer.reserve(_flush_size);
+	}
+
+	container_writer::~container_writer(void)
+	{
+	}
+
+	void container_writer::begin(const value_container& header)
+	{
+		_remained.clear();
+
+		append(converter::to_string(header.serialize_header()));
+		append("@data={");
+	}
+
+	bool container_writer::end(void)
+	{
+		append("};");
+		flush();
+
+		bool completed = _remained.empty();
+		_remained.clear();
+
+		return completed;
+	}
+
+	void container_writer::begin_container(const std::wstring& name, const long& count)
+	{
+		begin_record(name, value_types::container_value);
+		fmt::format_to(std::back_inserter(_buffer), "{}", count);
+		end_record();
+
+		_remained.push_back(count);
+	}
+
+	bool container_writer::end_container(void)
+	{
+		if (_remained.empty())
+		{
+			return false;
+		}
+
+		bool completed = _remained.back() == 0;
+		_remained.pop_back();
+
+		return completed;
+	}
+
+	void container_writer::add(std::shared_ptr<value> item)
+	{
+		if (item == nullptr)
+		{
+			return;
+		}
+
+		if (!_remained.empty())
+		{
+			--_remained.back();
+		}
+
+		item->append_serialized(_buffer, _length_prefixed_strings);
+
+		if (_flush != nullptr && _buffer.size() >= _flush_size)
+		{
+			flush();
+		}
+	}
+
+	void container_writer::add(const std::wstring& name, const bool& data)
+	{
+		begin_record(name, value_types::bool_value);
+		append(data ? "true" : "false");
+		end_record();
+	}
+
+	void container_writer::add(const std::wstring& name, const short& data)
+	{
+		add_numeric(name, value_types::short_value, data);
+	}
+
+	void container_writer::add(const std::wstring& name, const unsigned short& data)
+	{
+		add_numeric(name, value_types::ushort_value, data);
+	}
+
+	void container_writer::add(const std::wstring& name, const int& data)
+	{
+		add_numeric(name, value_types::int_value, data);
+	}
+
+	void container_writer::add(const std::wstring& name, const unsigned int& data)
+	{
+		add_numeric(name, value_types::uint_value, data);
+	}
+
+	void container_writer::add(const std::wstring& name, const long& data)
+	{
+		add_numeric(name, value_types::long_value, data);
+	}
+
+	void container_writer::add(const std::wstring& name, const unsigned long& data)
+	{
+		add_numeric(name, value_types::ulong_value, data);
+	}
+
+	void container_writer::add(const std::wstring& name, const long long& data)
+	{
+		add_numeric(name, value_types::llong_value, data);
+	}
+
+	void container_writer::add(const std::wstring& name, const unsigned long long& data)
+	{
+		add_numeric(name, value_types::ullong_value, data);
+	}
+
+	void container_writer::add(const std::wstring& name, const float& data)
+	{
+		add_numeric(name, value_types::float_value, data);
+	}
+
+	void container_writer::add(const std::wstring& name, const double& data)
+	{
+		add_numeric(name, value_types::double_value, data);
+	}
+
+	// without this overload a narrow literal would bind to the bool overload
+	void container_writer::add(const std::wstring& name, const char* data)
+	{
+		add(name, std::string(data == nullptr ? "" : data));
+	}
+
+	void container_writer::add(const std::wstring& name, const wchar_t* data)
+	{
+		add(name, std::wstring(data == nullptr ? L"" : data));
+	}
+
+	void container_writer::add(const std::wstring& name, const std::string& data)
+	{
+		if (!_length_prefixed_strings)
+		{
+			begin_record(name, value_types::string_value);
+			append(string_value::escape(data.data(), data.size()));
+			end_record();
+
+			return;
+		}
+
+		_buffer.push_back('[');
+		append(converter::to_string(name));
+		fmt::format_to(std::back_inserter(_buffer), ",{},{}:", static_cast<char>(LENGTH_PREFIXED_STRING[0]), data.size());
+		append(data);
+		end_record();
+	}
+
+	void container_writer::add(const std::wstring& name, const std::wstring& data)
+	{
+		add(name, converter::to_string(data));
+	}
+
+	void container_writer::add(const std::wstring& name, const std::vector<unsigned char>& data)
+	{
+		add(name, data.data(), data.size());
+	}
+
+	void container_writer::add(const std::wstring& name, const unsigned char* data, const size_t& size)
+	{
+		begin_record(name, value_types::bytes_value);
+		if (data != nullptr && size > 0)
+		{
+			size_t offset = _buffer.size();
+			_buffer.resize(offset + converter::base64_length(size));
+			converter::to_base64(data, size, &_buffer[offset]);
+		}
+		end_record();
+	}
+
+	const std::vector<unsigned char>& container_writer::buffer(void) const
+	{
+		return _buffer;
+	}
+
+	size_t container_writer::written(void) const
+	{
+		return _written + _buffer.size();
+	}
+
+	template <typename T> void container_writer::add_numeric(const std::wstring& name, const value_types& type, const T& data)
+	{
+		begin_record(name, type);
+		fmt::format_to(std::back_inserter(_buffer), "{}", data);
+		end_record();
+	}
+
+	void container_writer::begin_record(const std::wstring& name, const value_types& type)
+	{
+		_buffer.push_back('[');
+		append(converter::to_string(name));
+		_buffer.push_back(',');
+		_buffer.push_back(static_cast<unsigned char>(convert_value_type(type)[0]));
+		_buffer.push_back(',');
+	}
+
+	void container_writer::end_record(void)
+	{
+		append("];");
+
+		// a value inside a container counts against the number announced by begin_container
+		if (!_remained.empty())
+		{
+			--_remained.back();
+		}
+
+		if (_flush != nullptr && _buffer.size() >= _flush_size)
+		{
+			flush();
+		}
+	}
+
+	void container_writer::append(const std::string& data)
+	{
+		_buffer.insert(_buffer.end(), data.begin(), data.end());
+	}
+
+	void container_writer::flush(void)
+	{
+		if (_flush == nullptr || _buffer.empty())
+		{
+			return;
+		}
+
+		_flush(_buffer);
+		_written += _buffer.size();
+		_buffer.clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "container.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace container
+{
+	class container_writer
+	{
+	public:
+		container_writer(const std::function<void(const std::vector<unsigned char>&)>& flush = nullptr, const size_t& flush_size = 65536,
+			const bool& length_prefixed_strings = false);
+		~container_writer(void);
+
+	public:
+		void begin(const value_container& header);
+		bool end(void);
+
+	public:
+		void begin_container(const std::wstring& name, const long& count);
+		bool end_container(void);
+
+	public:
+		void add(std::shared_ptr<value> item);
+		void add(const std::wstring& name, const bool& data);
+		void add(const std::wstring& name, const short& data);
+		void add(const std::wstring& name, const unsigned short& data);
+		void add(const std::wstring& name, const int& data);
+		void add(const std::wstring& name, const unsigned int& data);
+		void add(const std::wstring& name, const long& data);
+		void add(const std::wstring& name, const unsigned long& data);
+		void add(const std::wstring& name, const long long& data);
+		void add(const std::wstring& name, const unsigned long long& data);
+		void add(const std::wstring& name, const float& data);
+		void add(const std::wstring& name, const double& data);
+		void add(const std::wstring& name, const char* data);
+		void add(const std::wstring& name, const wchar_t* data);
+		void add(const std::wstring& name, const std::string& data);
+		void add(const std::wstring& name, const std::wstring& data);
+		void add(const std::wstring& name, const std::vector<unsigned char>& data);
+		void add(const std::wstring& name, const unsigned char* data, const size_t& size);
+
+	public:
+		const std::vector<unsigned char>& buffer(void) const;
+		size_t written(void) const;
+
+	protected:
+		template <typename T> void add_numeric(const std::wstring& name, const value_types& type, const T& data);
+		void begin_record(const std::wstring& name, const value_types& type);
+		void end_record(void);
+		void append(const std::string& data);
+		void flush(void);
+
+	private:
+		size_t _flush_size;
+		size_t _written;
+		bool _length_prefixed_strings;
+		std::vector<long> _remained;
+		std::vector<unsigned char> _buffer;
+		std::function<void(const std::vector<unsigned char>&)> _flush;
+	};
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+namespace container
+{
+	struct field_token
+	{
+		size_t offset;
+		size_t name_offset;
+		size_t name_length;
+		size_t type_offset;
+		size_t type_length;
+		size_t value_offset;
+		size_t value_length;
+	};
+
+	bool next_field(const std::wstring& data, const size_t& end, size_t& position, field_token& token);
+	bool is_length_prefixed(const std::wstring& data, const field_token& token);
+	long child_count(const std::wstring& data, const field_token& token);
+}
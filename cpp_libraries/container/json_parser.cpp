@@ -0,0 +1,440 @@
+#include "json_parser.h"
+
+#include "container.h"
+
+#include "values/bool_value.h"
+#include "values/llong_value.h"
+#include "values/ullong_value.h"
+#include "values/double_value.h"
+#include "values/string_value.h"
+#include "values/container_value.h"
+
+#include <cwchar>
+#include <cwctype>
+#include <climits>
+
+namespace container
+{
+	// nested objects and arrays are parsed recursively, so a hostile document could otherwise exhaust the stack
+	constexpr size_t MAX_DEPTH = 256;
+
+	json_parser::json_parser(const std::wstring& source)
+		: _source(source), _position(0), _depth(0)
+	{
+	}
+
+	bool json_parser::parse(const std::wstring& source, value_container& target)
+	{
+		json_parser parser(source);
+
+		return parser.parse_document(target);
+	}
+
+	bool json_parser::parse_document(value_container& target)
+	{
+		if (!next_is(L'{'))
+		{
+			return false;
+		}
+
+		std::vector<std::shared_ptr<value>> units;
+		if (!next_is(L'}'))
+		{
+			do
+			{
+				std::wstring key;
+				if (!parse_string(key) || !next_is(L':'))
+				{
+					return false;
+				}
+
+				// the layout written by value_container::to_json is read back into the header and the values
+				skip_spaces();
+				bool is_array = _position < _source.size() && _source[_position] == L'[';
+				if (is_array && key == L"header")
+				{
+					if (!parse_header(target))
+					{
+						return false;
+					}
+
+					continue;
+				}
+
+				if (is_array && key == L"values")
+				{
+					++_position;
+					if (!parse_elements(key, units))
+					{
+						return false;
+					}
+
+					continue;
+				}
+
+				if (!parse_value(key, units))
+				{
+					return false;
+				}
+			} while (next_is(L','));
+
+			if (!next_is(L'}'))
+			{
+				return false;
+			}
+		}
+
+		// anything after the closing brace means the source was not a single document
+		skip_spaces();
+		if (_position != _source.size())
+		{
+			return false;
+		}
+
+		target.set_units(units);
+
+		return true;
+	}
+
+	bool json_parser::parse_header(value_container& target)
+	{
+		std::wstring target_id = target.target_id();
+		std::wstring target_sub_id = target.target_sub_id();
+		std::wstring source_id = target.source_id();
+		std::wstring source_sub_id = target.source_sub_id();
+		std::wstring message_type = target.message_type();
+		std::wstring version = target.version();
+
+		std::vector<std::shared_ptr<value>> fields;
+		++_position;
+		if (!parse_elements(L"header", fields))
+		{
+			return false;
+		}
+
+		for (auto& field : fields)
+		{
+			if (field->name() == L"target_id") { target_id = field->to_string(); }
+			else if (field->name() == L"target_sub_id") { target_sub_id = field->to_string(); }
+			else if (field->name() == L"source_id") { source_id = field->to_string(); }
+			else if (field->name() == L"source_sub_id") { source_sub_id = field->to_string(); }
+			else if (field->name() == L"message_type") { message_type = field->to_string(); }
+			else if (field->name() == L"version") { version = field->to_string(); }
+		}
+
+		target.set_target(target_id, target_sub_id);
+		target.set_source(source_id, source_sub_id);
+		target.set_message_type(message_type);
+		target.set_version(version);
+
+		return true;
+	}
+
+	// object members become values named by their keys
+	bool json_parser::parse_members(std::vector<std::shared_ptr<value>>& target)
+	{
+		if (next_is(L'}'))
+		{
+			return true;
+		}
+
+		do
+		{
+			std::wstring key;
+			if (!parse_string(key) || !next_is(L':') || !parse_value(key, target))
+			{
+				return false;
+			}
+		} while (next_is(L','));
+
+		return next_is(L'}');
+	}
+
+	// object elements are flattened into the array owner, as value::to_json wraps every child in its own object
+	bool json_parser::parse_elements(const std::wstring& name, std::vector<std::shared_ptr<value>>& target)
+	{
+		if (next_is(L']'))
+		{
+			return true;
+		}
+
+		do
+		{
+			if (next_is(L'{'))
+			{
+				if (!parse_members(target))
+				{
+					return false;
+				}
+
+				continue;
+			}
+
+			if (!parse_value(name, target))
+			{
+				return false;
+			}
+		} while (next_is(L','));
+
+		return next_is(L']');
+	}
+
+	bool json_parser::parse_value(const std::wstring& name, std::vector<std::shared_ptr<value>>& target)
+	{
+		skip_spaces();
+		if (_position >= _source.size())
+		{
+			return false;
+		}
+
+		wchar_t character = _source[_position];
+		if (character == L'{' || character == L'[')
+		{
+			if (_depth >= MAX_DEPTH)
+			{
+				return false;
+			}
+
+			++_position;
+			++_depth;
+
+			std::vector<std::shared_ptr<value>> children;
+			bool parsed = (character == L'{') ? parse_members(children) : parse_elements(name, children);
+			--_depth;
+			if (!parsed)
+			{
+				return false;
+			}
+
+			std::shared_ptr<value> container = std::make_shared<container_value>(name, children);
+			for (auto& child : children)
+			{
+				child->set_parent(container);
+			}
+			target.push_back(container);
+
+			return true;
+		}
+
+		if (character == L'"')
+		{
+			std::wstring text;
+			if (!parse_string(text))
+			{
+				return false;
+			}
+
+			target.push_back(std::make_shared<string_value>(name, text));
+
+			return true;
+		}
+
+		if (parse_literal(L"true"))
+		{
+			target.push_back(std::make_shared<bool_value>(name, true));
+
+			return true;
+		}
+
+		if (parse_literal(L"false"))
+		{
+			target.push_back(std::make_shared<bool_value>(name, false));
+
+			return true;
+		}
+
+		if (parse_literal(L"null"))
+		{
+			target.push_back(std::make_shared<value>(name, nullptr, 0, value_types::null_value));
+
+			return true;
+		}
+
+		std::shared_ptr<value> number = parse_number(name);
+		if (number == nullptr)
+		{
+			return false;
+		}
+
+		target.push_back(number);
+
+		return true;
+	}
+
+	bool json_parser::parse_string(std::wstring& target)
+	{
+		if (!next_is(L'"'))
+		{
+			return false;
+		}
+
+		target.clear();
+		size_t start = _position;
+		while (_position < _source.size())
+		{
+			wchar_t character = _source[_position];
+			if (character == L'"')
+			{
+				target.append(_source, start, _position - start);
+				++_position;
+
+				return true;
+			}
+
+			if (character != L'\\')
+			{
+				++_position;
+				continue;
+			}
+
+			target.append(_source, start, _position - start);
+			if (++_position >= _source.size())
+			{
+				return false;
+			}
+
+			switch (_source[_position++])
+			{
+			case L'"': target.push_back(L'"'); break;
+			case L'\\': target.push_back(L'\\'); break;
+			case L'/': target.push_back(L'/'); break;
+			case L'b': target.push_back(L'\b'); break;
+			case L'f': target.push_back(L'\f'); break;
+			case L'n': target.push_back(L'\n'); break;
+			case L'r': target.push_back(L'\r'); break;
+			case L't': target.push_back(L'\t'); break;
+			case L'u':
+				{
+					unsigned long code = 0;
+					if (!parse_hex(_position, code))
+					{
+						return false;
+					}
+					_position += 4;
+
+					// a surrogate pair is joined when wchar_t holds full code points
+					unsigned long low = 0;
+					if (sizeof(wchar_t) == 4 && code >= 0xD800 && code < 0xDC00 && _position + 6 <= _source.size() &&
+						_source[_position] == L'\\' && _source[_position + 1] == L'u' && parse_hex(_position + 2, low))
+					{
+						if (low >= 0xDC00 && low < 0xE000)
+						{
+							code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+							_position += 6;
+						}
+					}
+
+					target.push_back(static_cast<wchar_t>(code));
+				}
+				break;
+			default: return false;
+			}
+
+			start = _position;
+		}
+
+		return false;
+	}
+
+	// exactly four hex digits, since wcstoul would also accept signs, spaces and shorter runs
+	bool json_parser::parse_hex(const size_t& position, unsigned long& code)
+	{
+		if (position + 4 > _source.size())
+		{
+			return false;
+		}
+
+		code = 0;
+		for (size_t index = position; index < position + 4; ++index)
+		{
+			wchar_t character = _source[index];
+			if (!iswxdigit(character))
+			{
+				return false;
+			}
+
+			code = (code << 4) | (unsigned long)(character <= L'9' ? character - L'0' : (towlower(character) - L'a' + 10));
+		}
+
+		return true;
+	}
+
+	std::shared_ptr<value> json_parser::parse_number(const std::wstring& name)
+	{
+		size_t start = _position;
+		bool floating = false;
+		while (_position < _source.size())
+		{
+			wchar_t character = _source[_position];
+			if (character == L'.' || character == L'e' || character == L'E')
+			{
+				floating = true;
+			}
+			else if (!(character >= L'0' && character <= L'9') && character != L'-' && character != L'+')
+			{
+				break;
+			}
+
+			++_position;
+		}
+
+		if (_position == start)
+		{
+			return nullptr;
+		}
+
+		// JSON numbers carry no type, so integers become long long values and the rest double values
+		const wchar_t* number = _source.c_str() + start;
+		if (floating)
+		{
+			return std::make_shared<double_value>(name, std::wcstod(number, nullptr));
+		}
+
+		if (_source[start] == L'-')
+		{
+			return std::make_shared<llong_value>(name, std::wcstoll(number, nullptr, 10));
+		}
+
+		unsigned long long parsed = std::wcstoull(number, nullptr, 10);
+		if (parsed > static_cast<unsigned long long>(LLONG_MAX))
+		{
+			return std::make_shared<ullong_value>(name, parsed);
+		}
+
+		return std::make_shared<llong_value>(name, static_cast<long long>(parsed));
+	}
+
+	bool json_parser::parse_literal(const wchar_t* literal)
+	{
+		size_t length = wcslen(literal);
+		if (_source.compare(_position, length, literal) != 0)
+		{
+			return false;
+		}
+
+		_position += length;
+
+		return true;
+	}
+
+	bool json_parser::next_is(const wchar_t& character)
+	{
+		skip_spaces();
+		if (_position >= _source.size() || _source[_position] != character)
+		{
+			return false;
+		}
+
+		++_position;
+
+		return true;
+	}
+
+	void json_parser::skip_spaces(void)
+	{
+		while (_position < _source.size() && iswspace(_source[_position]))
+		{
+			++_position;
+		}
+	}
+}
\ No newline at end of file
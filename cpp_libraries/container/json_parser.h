@@ -0,0 +1,39 @@
+#pragma once
+
+#include "value.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace container
+{
+	class value_container;
+
+	class json_parser
+	{
+	public:
+		static bool parse(const std::wstring& source, value_container& target);
+
+	protected:
+		json_parser(const std::wstring& source);
+
+	protected:
+		bool parse_document(value_container& target);
+		bool parse_header(value_container& target);
+		bool parse_members(std::vector<std::shared_ptr<value>>& target);
+		bool parse_elements(const std::wstring& name, std::vector<std::shared_ptr<value>>& target);
+		bool parse_value(const std::wstring& name, std::vector<std::shared_ptr<value>>& target);
+		bool parse_string(std::wstring& target);
+		bool parse_hex(const size_t& position, unsigned long& code);
+		std::shared_ptr<value> parse_number(const std::wstring& name);
+		bool parse_literal(const wchar_t* literal);
+		bool next_is(const wchar_t& character);
+		void skip_spaces(void);
+
+	private:
+		const std::wstring& _source;
+		size_t _position;
+		size_t _depth;
+	};
+}
@@ -0,0 +1,327 @@
+#pragma once
+
+#include "container.h"
+#include "value_types.h"
+#include "field_scanner.h"
+
+#include "converting.h"
+#include "values/string_value.h"
+
+#include <tuple>
+#include <cwchar>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <type_traits>
+
+#include "fmt/format.h"
+
+namespace container
+{
+	template <typename Message, typename T>
+	struct message_field
+	{
+		const wchar_t* name;
+		T Message::* member;
+		const wchar_t* item_name;
+	};
+
+	template <typename Message, typename T>
+	constexpr message_field<Message, T> make_field(const wchar_t* name, T Message::* member, const wchar_t* item_name = nullptr)
+	{
+		return { name, member, item_name };
+	}
+
+	inline void begin_record(std::wstring& target, const wchar_t* name, const value_types& type)
+	{
+		target.push_back(L'[');
+		target.append(name);
+		target.push_back(L',');
+		target.append(convert_value_type(type));
+		target.push_back(L',');
+	}
+
+	inline void end_record(std::wstring& target)
+	{
+		target.append(L"];");
+	}
+
+	template <typename T> struct field_codec;
+
+	template <typename T>
+	struct numeric_codec
+	{
+		static void write(std::wstring& target, const wchar_t* name, const T& source, const wchar_t*, const bool&)
+		{
+			begin_record(target, name, field_codec<T>::type);
+			fmt::format_to(std::back_inserter(target), L"{}", source);
+			end_record(target);
+		}
+
+		static void read(const std::wstring& data, const size_t&, size_t&, const field_token& token, T& target, const wchar_t*)
+		{
+			// the value is terminated by the "];" behind it, so it is parsed in place
+			const wchar_t* source = data.c_str() + token.value_offset;
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				target = static_cast<T>(std::wcstod(source, nullptr));
+			}
+			else if constexpr (std::is_signed_v<T>)
+			{
+				target = static_cast<T>(std::wcstoll(source, nullptr, 10));
+			}
+			else
+			{
+				target = static_cast<T>(std::wcstoull(source, nullptr, 10));
+			}
+		}
+	};
+
+	template <> struct field_codec<short> : numeric_codec<short> { static constexpr value_types type = value_types::short_value; };
+	template <> struct field_codec<unsigned short> : numeric_codec<unsigned short> { static constexpr value_types type = value_types::ushort_value; };
+	template <> struct field_codec<int> : numeric_codec<int> { static constexpr value_types type = value_types::int_value; };
+	template <> struct field_codec<unsigned int> : numeric_codec<unsigned int> { static constexpr value_types type = value_types::uint_value; };
+	template <> struct field_codec<long> : numeric_codec<long> { static constexpr value_types type = value_types::long_value; };
+	template <> struct field_codec<unsigned long> : numeric_codec<unsigned long> { static constexpr value_types type = value_types::ulong_value; };
+	template <> struct field_codec<long long> : numeric_codec<long long> { static constexpr value_types type = value_types::llong_value; };
+	template <> struct field_codec<unsigned long long> : numeric_codec<unsigned long long> { static constexpr value_types type = value_types::ullong_value; };
+	template <> struct field_codec<float> : numeric_codec<float> { static constexpr value_types type = value_types::float_value; };
+	template <> struct field_codec<double> : numeric_codec<double> { static constexpr value_types type = value_types::double_value; };
+
+	template <>
+	struct field_codec<bool>
+	{
+		static constexpr value_types type = value_types::bool_value;
+
+		static void write(std::wstring& target, const wchar_t* name, const bool& source, const wchar_t*, const bool&)
+		{
+			begin_record(target, name, type);
+			target.append(source ? L"true" : L"false");
+			end_record(target);
+		}
+
+		static void read(const std::wstring& data, const size_t&, size_t&, const field_token& token, bool& target, const wchar_t*)
+		{
+			target = data.compare(token.value_offset, token.value_length, L"true") == 0;
+		}
+	};
+
+	template <>
+	struct field_codec<std::wstring>
+	{
+		static constexpr value_types type = value_types::string_value;
+
+		// escaped by default, since a baseline peer cannot read the length-prefixed form
+		static void write(std::wstring& target, const wchar_t* name, const std::wstring& source, const wchar_t*, const bool& length_prefixed)
+		{
+			if (!length_prefixed)
+			{
+				std::string temp = converting::converter::to_string(source);
+
+				begin_record(target, name, type);
+				target.append(converting::converter::to_wstring(string_value::escape(temp.data(), temp.size())));
+				end_record(target);
+				return;
+			}
+
+			target.push_back(L'[');
+			target.append(name);
+			target.push_back(L',');
+			target.append(LENGTH_PREFIXED_STRING);
+			target.push_back(L',');
+			fmt::format_to(std::back_inserter(target), L"{}:", converting::converter::utf8_length(source));
+			target.append(source);
+			end_record(target);
+		}
+
+		static void read(const std::wstring& data, const size_t&, size_t&, const field_token& token, std::wstring& target, const wchar_t*)
+		{
+			target.assign(data, token.value_offset, token.value_length);
+			if (is_length_prefixed(data, token) || target.find(L'<') == std::wstring::npos)
+			{
+				return;
+			}
+
+			std::string temp = converting::converter::to_string(target);
+			target = converting::converter::to_wstring(string_value::unescape(temp.data(), temp.size()));
+		}
+	};
+
+	template <typename T, value_types array_type>
+	struct block_codec
+	{
+		static constexpr value_types type = array_type;
+
+		static void write(std::wstring& target, const wchar_t* name, const std::vector<T>& source, const wchar_t*, const bool&)
+		{
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(source.data());
+			size_t size = source.size() * sizeof(T);
+
+			begin_record(target, name, type);
+			size_t offset = target.size();
+			target.resize(offset + converting::converter::base64_length(size));
+			converting::converter::to_base64(bytes, size, &target[offset]);
+			end_record(target);
+		}
+
+		static void read(const std::wstring& data, const size_t&, size_t&, const field_token& token, std::vector<T>& target, const wchar_t*)
+		{
+			std::vector<unsigned char> bytes = converting::converter::from_base64(data.c_str() + token.value_offset, token.value_length);
+
+			target.resize(bytes.size() / sizeof(T));
+			if (!target.empty())
+			{
+				memcpy(target.data(), bytes.data(), target.size() * sizeof(T));
+			}
+		}
+	};
+
+	template <> struct field_codec<std::vector<unsigned char>> : block_codec<unsigned char, value_types::bytes_value> {};
+	template <> struct field_codec<std::vector<int>> : block_codec<int, value_types::int_array_value> {};
+	template <> struct field_codec<std::vector<long long>> : block_codec<long long, value_types::llong_array_value> {};
+	template <> struct field_codec<std::vector<float>> : block_codec<float, value_types::float_array_value> {};
+	template <> struct field_codec<std::vector<double>> : block_codec<double, value_types::double_array_value> {};
+
+	// a list of strings travels as a container value holding one string value per item
+	template <>
+	struct field_codec<std::vector<std::wstring>>
+	{
+		static constexpr value_types type = value_types::container_value;
+
+		static void write(std::wstring& target, const wchar_t* name, const std::vector<std::wstring>& source, const wchar_t* item_name, const bool& length_prefixed)
+		{
+			begin_record(target, name, type);
+			fmt::format_to(std::back_inserter(target), L"{}", source.size());
+			end_record(target);
+
+			for (auto& item : source)
+			{
+				field_codec<std::wstring>::write(target, item_name, item, nullptr, length_prefixed);
+			}
+		}
+
+		static void read(const std::wstring& data, const size_t& end, size_t& position, const field_token& token, std::vector<std::wstring>& target, const wchar_t* item_name)
+		{
+			target.clear();
+
+			field_token child;
+			long remained = child_count(data, token);
+			while (remained > 0 && next_field(data, end, position, child))
+			{
+				--remained;
+				remained += child_count(data, child);
+
+				if (item_name == nullptr || data.compare(child.name_offset, child.name_length, item_name) != 0)
+				{
+					continue;
+				}
+
+				std::wstring item;
+				field_codec<std::wstring>::read(data, end, position, child, item, nullptr);
+				target.push_back(std::move(item));
+			}
+		}
+	};
+
+	// Message declares its fields once:
+	//   static constexpr const wchar_t* message_type = L"...";
+	//   static constexpr auto fields(void) { return std::make_tuple(make_field(L"name", &Message::name), ...); }
+	// strings are only written length-prefixed when the caller knows the peer reads that form
+	template <typename Message>
+	class message_schema
+	{
+	public:
+		static std::wstring serialize(const Message& message, const bool& length_prefixed = false)
+		{
+			std::wstring result = L"@data={";
+			std::apply([&result, &message, &length_prefixed](const auto&... field)
+				{
+					(write_field(result, field, message, length_prefixed), ...);
+				}, Message::fields());
+			result.append(L"};");
+
+			return result;
+		}
+
+		static bool deserialize(const std::wstring& data, Message& message)
+		{
+			size_t position = 0;
+			size_t end = data.size();
+			field_token token;
+			while (next_field(data, end, position, token))
+			{
+				bool matched = std::apply([&data, &end, &position, &token, &message](const auto&... field)
+					{
+						return (read_field(data, end, position, token, field, message) || ...);
+					}, Message::fields());
+
+				if (matched)
+				{
+					continue;
+				}
+
+				// unknown fields are stepped over together with their children
+				field_token child;
+				long remained = child_count(data, token);
+				while (remained > 0 && next_field(data, end, position, child))
+				{
+					remained += child_count(data, child) - 1;
+				}
+			}
+
+			return true;
+		}
+
+	public:
+		static std::shared_ptr<value_container> to_container(const Message& message, const std::wstring& target_id, const std::wstring& target_sub_id,
+			const bool& length_prefixed = false)
+		{
+			std::shared_ptr<value_container> result = std::make_shared<value_container>(target_id, target_sub_id, Message::message_type);
+			result->set_length_prefixed_strings(length_prefixed);
+			result->set_datas(serialize(message, length_prefixed));
+
+			return result;
+		}
+
+		static std::shared_ptr<value_container> to_container(const Message& message, const std::wstring& source_id, const std::wstring& source_sub_id,
+			const std::wstring& target_id, const std::wstring& target_sub_id, const bool& length_prefixed = false)
+		{
+			std::shared_ptr<value_container> result = std::make_shared<value_container>(source_id, source_sub_id, target_id, target_sub_id, Message::message_type);
+			result->set_length_prefixed_strings(length_prefixed);
+			result->set_datas(serialize(message, length_prefixed));
+
+			return result;
+		}
+
+		static bool from_container(std::shared_ptr<value_container> container, Message& message)
+		{
+			if (container == nullptr || container->message_type() != Message::message_type)
+			{
+				return false;
+			}
+
+			return deserialize(container->datas(), message);
+		}
+
+	private:
+		template <typename T>
+		static void write_field(std::wstring& target, const message_field<Message, T>& field, const Message& message, const bool& length_prefixed)
+		{
+			field_codec<T>::write(target, field.name, message.*(field.member), field.item_name, length_prefixed);
+		}
+
+		template <typename T>
+		static bool read_field(const std::wstring& data, const size_t& end, size_t& position, const field_token& token, const message_field<Message, T>& field, Message& message)
+		{
+			if (data.compare(token.name_offset, token.name_length, field.name) != 0)
+			{
+				return false;
+			}
+
+			field_codec<T>::read(data, end, position, token, message.*(field.member), field.item_name);
+
+			return true;
+		}
+	};
+}
@@ -0,0 +1,280 @@
+#include "packet_file.h"
+
+#include <cstring>
+#include <filesystem>
+
+namespace container
+{
+	constexpr size_t RECORD_HEADER_SIZE = sizeof(unsigned long long);
+
+	packet_file_writer::packet_file_writer(const std::wstring& file_path)
+		: _offset(0), _count(0)
+	{
+		recover(file_path);
+
+		_data.open(std::filesystem::path(file_path), std::ios::binary | std::ios::app);
+		_index.open(std::filesystem::path(file_path + L".index"), std::ios::binary | std::ios::app);
+	}
+
+	packet_file_writer::~packet_file_writer(void)
+	{
+		flush();
+	}
+
+	bool packet_file_writer::is_open(void) const
+	{
+		return _data.is_open() && _index.is_open();
+	}
+
+	bool packet_file_writer::append(std::shared_ptr<value_container> packet)
+	{
+		if (packet == nullptr)
+		{
+			return false;
+		}
+
+		return append(packet->serialize_array());
+	}
+
+	bool packet_file_writer::append(const std::vector<unsigned char>& packet)
+	{
+		return append(packet.data(), packet.size());
+	}
+
+	bool packet_file_writer::append(const unsigned char* packet, const size_t& size)
+	{
+		if (!is_open() || (packet == nullptr && size > 0))
+		{
+			return false;
+		}
+
+		unsigned long long length = size;
+		_data.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		_data.write(reinterpret_cast<const char*>(packet), size);
+		_index.write(reinterpret_cast<const char*>(&_offset), sizeof(_offset));
+		if (!_data.good() || !_index.good())
+		{
+			return false;
+		}
+
+		_offset += RECORD_HEADER_SIZE + size;
+		++_count;
+
+		return true;
+	}
+
+	void packet_file_writer::flush(void)
+	{
+		if (_data.is_open())
+		{
+			_data.flush();
+		}
+
+		if (_index.is_open())
+		{
+			_index.flush();
+		}
+	}
+
+	unsigned long long packet_file_writer::count(void) const
+	{
+		return _count;
+	}
+
+	void packet_file_writer::recover(const std::wstring& file_path)
+	{
+		std::vector<unsigned long long> offsets;
+		bool rebuilt = false;
+		{
+			packet_file_reader existing(file_path);
+			if (!existing.is_open())
+			{
+				// a missing or empty data file has no records, so offsets left in an old index would point past the first append
+				std::error_code ec;
+				std::filesystem::resize_file(std::filesystem::path(file_path + L".index"), 0, ec);
+
+				return;
+			}
+
+			_count = existing.count();
+			if (_count > 0)
+			{
+				const unsigned char* data = nullptr;
+				size_t size = 0;
+				existing.packet_bytes(_count - 1, data, size);
+				_offset = existing.record_offset(_count - 1) + RECORD_HEADER_SIZE + size;
+			}
+
+			rebuilt = existing.index_rebuilt();
+			if (rebuilt)
+			{
+				offsets.reserve(_count);
+				for (size_t index = 0; index < _count; ++index)
+				{
+					offsets.push_back(existing.record_offset(index));
+				}
+			}
+		}
+
+		if (!rebuilt)
+		{
+			return;
+		}
+
+		// the mapping is released above, so a torn tail can be cut and the index written again before appending
+		std::error_code ec;
+		std::filesystem::resize_file(std::filesystem::path(file_path), _offset, ec);
+
+		std::ofstream index(std::filesystem::path(file_path + L".index"), std::ios::binary | std::ios::trunc);
+		index.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(unsigned long long));
+	}
+
+	packet_file_reader::packet_file_reader(const std::wstring& file_path)
+		: _data(file_path), _index(file_path + L".index"), _use_rebuilt(false), _count(0)
+	{
+		if (index_matches())
+		{
+			_count = _index.size() / sizeof(unsigned long long);
+			return;
+		}
+
+		// a missing or stale index (e.g. the writer stopped between the two files) is recovered by walking the records
+		rebuild_index();
+	}
+
+	packet_file_reader::~packet_file_reader(void)
+	{
+	}
+
+	bool packet_file_reader::is_open(void) const
+	{
+		return _data.is_open();
+	}
+
+	size_t packet_file_reader::count(void) const
+	{
+		return _count;
+	}
+
+	bool packet_file_reader::index_rebuilt(void) const
+	{
+		return _use_rebuilt;
+	}
+
+	unsigned long long packet_file_reader::record_offset(const size_t& index) const
+	{
+		if (_use_rebuilt)
+		{
+			return _rebuilt[index];
+		}
+
+		unsigned long long result = 0;
+		memcpy(&result, _index.data() + index * sizeof(result), sizeof(result));
+
+		return result;
+	}
+
+	bool packet_file_reader::packet_bytes(const size_t& index, const unsigned char*& data, size_t& size) const
+	{
+		data = nullptr;
+		size = 0;
+
+		if (index >= _count)
+		{
+			return false;
+		}
+
+		// the offsets come from a separate index file, so they are checked before the mapping is touched
+		unsigned long long start = record_offset(index);
+		if (start > _data.size() || _data.size() - start < RECORD_HEADER_SIZE)
+		{
+			return false;
+		}
+
+		unsigned long long length = record_size(start);
+		if (length > _data.size() - start - RECORD_HEADER_SIZE)
+		{
+			return false;
+		}
+
+		data = _data.data() + start + RECORD_HEADER_SIZE;
+		size = static_cast<size_t>(length);
+
+		return true;
+	}
+
+	std::shared_ptr<value_container> packet_file_reader::get(const size_t& index, const bool& parse_only_header) const
+	{
+		const unsigned char* data = nullptr;
+		size_t size = 0;
+		if (!packet_bytes(index, data, size))
+		{
+			return nullptr;
+		}
+
+		std::shared_ptr<value_container> result = std::make_shared<value_container>();
+		result->deserialize(data, size, parse_only_header);
+
+		return result;
+	}
+
+	bool packet_file_reader::index_matches(void) const
+	{
+		if (!_data.is_open() || !_index.is_open() || _index.size() % sizeof(unsigned long long) != 0)
+		{
+			return false;
+		}
+
+		// records are written back to back, so every offset must be where the previous record ends
+		unsigned long long expected = 0;
+		for (size_t position = 0; position < _index.size(); position += sizeof(unsigned long long))
+		{
+			unsigned long long offset = 0;
+			memcpy(&offset, _index.data() + position, sizeof(offset));
+			if (offset != expected || offset >= _data.size() || _data.size() - offset < RECORD_HEADER_SIZE)
+			{
+				return false;
+			}
+
+			unsigned long long length = record_size(offset);
+			if (length > _data.size() - offset - RECORD_HEADER_SIZE)
+			{
+				return false;
+			}
+
+			expected = offset + RECORD_HEADER_SIZE + length;
+		}
+
+		return expected == _data.size();
+	}
+
+	void packet_file_reader::rebuild_index(void)
+	{
+		_use_rebuilt = true;
+		_rebuilt.clear();
+
+		unsigned long long position = 0;
+		while (position + RECORD_HEADER_SIZE <= _data.size())
+		{
+			unsigned long long size = record_size(position);
+			if (size > _data.size() - position - RECORD_HEADER_SIZE)
+			{
+				// a torn record at the tail is left out
+				break;
+			}
+
+			_rebuilt.push_back(position);
+			position += RECORD_HEADER_SIZE + size;
+		}
+
+		_count = _rebuilt.size();
+	}
+
+	unsigned long long packet_file_reader::record_size(const unsigned long long& offset) const
+	{
+		unsigned long long result = 0;
+		memcpy(&result, _data.data() + offset, sizeof(result));
+
+		return result;
+	}
+}
\ No newline at end of file
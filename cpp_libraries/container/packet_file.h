@@ -0,0 +1,66 @@
+#pragma once
+
+#include "container.h"
+
+#include "file_mapping.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+
+namespace container
+{
+	// records are an 8 byte length followed by the serialized packet;
+	// "<path>.index" holds the 8 byte offset of every record in order
+	class packet_file_writer
+	{
+	public:
+		packet_file_writer(const std::wstring& file_path);
+		~packet_file_writer(void);
+
+	public:
+		bool is_open(void) const;
+		bool append(std::shared_ptr<value_container> packet);
+		bool append(const std::vector<unsigned char>& packet);
+		bool append(const unsigned char* packet, const size_t& size);
+		void flush(void);
+		unsigned long long count(void) const;
+
+	protected:
+		void recover(const std::wstring& file_path);
+
+	private:
+		std::ofstream _data;
+		std::ofstream _index;
+		unsigned long long _offset;
+		unsigned long long _count;
+	};
+
+	class packet_file_reader
+	{
+	public:
+		packet_file_reader(const std::wstring& file_path);
+		~packet_file_reader(void);
+
+	public:
+		bool is_open(void) const;
+		size_t count(void) const;
+		bool index_rebuilt(void) const;
+		unsigned long long record_offset(const size_t& index) const;
+		bool packet_bytes(const size_t& index, const unsigned char*& data, size_t& size) const;
+		std::shared_ptr<value_container> get(const size_t& index, const bool& parse_only_header = true) const;
+
+	protected:
+		bool index_matches(void) const;
+		void rebuild_index(void);
+		unsigned long long record_size(const unsigned long long& offset) const;
+
+	private:
+		file_handling::file_mapping _data;
+		file_handling::file_mapping _index;
+		std::vector<unsigned long long> _rebuilt;
+		bool _use_rebuilt;
+		size_t _count;
+	};
+}
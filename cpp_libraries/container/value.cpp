@@ -16,7 +16,9 @@
 #include "values/uint_value.h"
 #include "values/ushort_value.h"
 #include "values/container_value.h"
+#include "values/array_value.h"
 
+#include <cmath>
 #include <sstream>
 
 #include "fmt/format.h"
@@ -27,6 +29,7 @@ namespace container
 
 	value::value(void) : _name(L""), _type(value_types::null_value), _size(0)
 	{
+		_numeric.ullong_data = 0;
 	}
 
 	value::value(std::shared_ptr<value> object)
@@ -34,8 +37,15 @@ namespace container
 		_name = object->name();
 		_type = object->type();
 		_size = object->size();
-		_parent = object->parent();
-		_units = object->children();
+		_numeric = object->_numeric;
+		_data = object->_data;
+
+		// the children stay linked to the source object, so this value gets its own copies
+		_units.reserve(object->_units.size());
+		for (auto& unit : object->_units)
+		{
+			_units.push_back(unit->copy());
+		}
 	}
 
 	value::value(const std::wstring& name, const std::vector<std::shared_ptr<value>>& units)
@@ -73,25 +83,57 @@ namespace container
 	void value::set_parent(std::shared_ptr<value> parent)
 	{
 		_parent = parent;
+		_owner_index = parent != nullptr ? parent->_index.tracker() : std::weak_ptr<std::atomic<bool>>();
+
+		link_units();
+	}
+
+	void value::set_owner_index(const value_index& owner_index)
+	{
+		_owner_index = owner_index.tracker();
 	}
 
 	void value::set_data(const unsigned char* data, const size_t& size, const value_types& type)
 	{
+		invalidate();
+
 		if (data == nullptr || size == 0)
 		{
 			_type = value_types::null_value;
 			_size = 0;
+			_numeric.ullong_data = 0;
 			_data.clear();
 			return;
 		}
 
 		_type = type;
 		_size = size;
+
+		if (is_inline_type(type) && size <= sizeof(numeric_storage))
+		{
+			_numeric.ullong_data = 0;
+			memcpy(_numeric.bytes, data, size);
+			_data.clear();
+			return;
+		}
+
 		_data = std::vector<unsigned char>(data, data + size);
 	}
 
 	void value::set_data(const std::wstring& name, const value_types& type, const std::wstring& data)
 	{
+		invalidate();
+
+		if (_name != name)
+		{
+			// the owner's name index still points at the old name; a top-level unit has no parent but still has its container's index
+			std::shared_ptr<std::atomic<bool>> owner_index = _owner_index.lock();
+			if (owner_index != nullptr)
+			{
+				owner_index->store(true);
+			}
+		}
+
 		_name = name;
 		_type = type;
 
@@ -111,10 +153,17 @@ namespace container
 		case value_types::bytes_value: set_byte_string(data); break;
 		case value_types::string_value: set_string(data); break;
 		case value_types::container_value: set_data((long)_wtol(data.c_str())); break;
+		case value_types::int_array_value:
+		case value_types::llong_array_value:
+		case value_types::float_array_value:
+		case value_types::double_array_value:
+			set_byte_string(data);
+			_type = type;
+			break;
 		}
 	}
 
-	std::wstring value::name(void) const
+	const std::wstring& value::name(void) const
 	{
 		return _name;
 	}
@@ -126,23 +175,16 @@ namespace container
 
 	std::wstring value::data(void) const
 	{
-		if (_type != value_types::string_value)
-		{
-			return to_string();
-		}
-
-		std::wstring temp = to_string();
-
-		converter::replace(temp, L"</0x0A;>", L"\r");
-		converter::replace(temp, L"</0x0B;>", L"\n");
-		converter::replace(temp, L"</0x0C;>", L" ");
-		converter::replace(temp, L"</0x0D;>", L"\t");
-
-		return temp;
+		return to_string();
 	}
 
 	size_t value::size(void) const
 	{
+		if (is_inline_type(_type))
+		{
+			return _size;
+		}
+
 		return _data.size();
 	}
 
@@ -180,24 +222,34 @@ namespace container
 
 	std::vector<std::shared_ptr<value>> value::value_array(const std::wstring& key)
 	{
-		std::vector<std::shared_ptr<value>> result_list;
+		return _index.collect(_units, key);
+	}
 
-		std::for_each(_units.begin(), _units.end(), [&key, &result_list](std::shared_ptr<value> source) 
-			{
-				if (source->name() == key)
-				{
-					result_list.push_back(source);
-				}
-			});
+	std::shared_ptr<value> value::find_value(const std::wstring& key, const unsigned int& index)
+	{
+		return _index.find(_units, key, index);
+	}
 
-		return result_list;
+	size_t value::value_count(const std::wstring& key)
+	{
+		return _index.count(_units, key);
 	}
 
 	const std::vector<unsigned char> value::to_bytes(void) const
 	{
+		if (is_inline_type(_type))
+		{
+			return std::vector<unsigned char>(_numeric.bytes, _numeric.bytes + _size);
+		}
+
 		return _data;
 	}
 
+	std::string value::to_utf8(const bool& original) const
+	{
+		return converter::to_string(to_string(original));
+	}
+
 	bool value::is_null(void) const
 	{
 		return _type == value_types::null_value;
@@ -232,85 +284,168 @@ namespace container
 		return _type == value_types::container_value;
 	}
 
+	bool value::is_array(void) const
+	{
+		return _type == value_types::int_array_value || _type == value_types::llong_array_value ||
+			_type == value_types::float_array_value || _type == value_types::double_array_value;
+	}
+
 	const std::wstring value::to_xml(void)
 	{
-		fmt::wmemory_buffer result;
-		result.clear();
+		std::wstring result;
+		append_xml(result);
 
-		if (_units.size() == 0)
-		{
-			fmt::format_to(std::back_inserter(result), L"<{0}>{1}</{0}>", name(), to_string(false));
+		return result;
+	}
 
-			return result.data();
-		}
+	const std::wstring value::to_json(void)
+	{
+		std::wstring result;
+		append_json(result);
 
-		fmt::format_to(std::back_inserter(result), L"<{}>", name());
-		for (auto& unit : _units)
+		return result;
+	}
+
+	void value::append_xml(std::wstring& target)
+	{
+		// walks the tree with an explicit stack so every node is written once into the same buffer
+		std::vector<std::pair<value*, size_t>> parents;
+		value* current = this;
+		while (current != nullptr)
 		{
-			fmt::format_to(std::back_inserter(result), L"{}", unit->to_xml());
-		}
-		fmt::format_to(std::back_inserter(result), L"</{}>", name());
+			target.push_back(L'<');
+			append_xml_text(target, current->_name);
+			target.push_back(L'>');
 
-		return result.data();
+			if (!current->_units.empty())
+			{
+				parents.push_back({ current, 0 });
+			}
+			else
+			{
+				if (!current->is_container())
+				{
+					append_xml_text(target, current->to_string());
+				}
+
+				target.append(L"</");
+				append_xml_text(target, current->_name);
+				target.push_back(L'>');
+			}
+
+			current = nullptr;
+			while (!parents.empty())
+			{
+				auto& parent = parents.back();
+				if (parent.second < parent.first->_units.size())
+				{
+					current = parent.first->_units[parent.second++].get();
+					break;
+				}
+
+				target.append(L"</");
+				append_xml_text(target, parent.first->_name);
+				target.push_back(L'>');
+				parents.pop_back();
+			}
+		}
 	}
 
-	const std::wstring value::to_json(void)
+	void value::append_json(std::wstring& target)
 	{
-		fmt::wmemory_buffer result;
-		result.clear();
-
-		if (_units.size() == 0)
+		std::vector<std::pair<value*, size_t>> parents;
+		value* current = this;
+		while (current != nullptr)
 		{
-			switch (_type)
+			if (current->is_container() || !current->_units.empty())
+			{
+				target.append(L"{ \"");
+				append_json_text(target, current->_name);
+				target.append(L"\":[");
+				parents.push_back({ current, 0 });
+			}
+			else
 			{
-			case value_types::bytes_value: 
-			case value_types::string_value: 
-				fmt::format_to(std::back_inserter(result), L"{}\"{}\":\"{}\"{}", L"{", name(), to_string(false), L"}"); break;
-			default:
-				fmt::format_to(std::back_inserter(result), L"{}\"{}\":{}{}", L"{", name(), to_string(false), L"}"); break;
+				target.append(L"{\"");
+				append_json_text(target, current->_name);
+				target.append(L"\":");
+				current->append_json_data(target);
+				target.push_back(L'}');
 			}
 
-			return result.data();
-		}
+			current = nullptr;
+			while (!parents.empty())
+			{
+				auto& parent = parents.back();
+				if (parent.second < parent.first->_units.size())
+				{
+					if (parent.second > 0)
+					{
+						target.push_back(L',');
+					}
 
-		fmt::format_to(std::back_inserter(result), L"{} \"{}\":[", L"{", name());
+					current = parent.first->_units[parent.second++].get();
+					break;
+				}
 
-		bool first = true;
-		for (auto& unit : _units)
-		{
-			fmt::format_to(std::back_inserter(result), first ? L"{}" : L",{}", unit->to_json());
-			first = false;
+				target.append(L"] }");
+				parents.pop_back();
+			}
 		}
+	}
 
-		fmt::format_to(std::back_inserter(result), L"] {}", L"}");
-		
-		return result.data();
+	const std::wstring value::serialize(const bool& length_prefixed)
+	{
+		std::wstring result;
+		append_serialized(result, length_prefixed);
+
+		return result;
 	}
 
-	const std::wstring value::serialize(void)
+	const std::vector<unsigned char> value::serialize_array(const bool& length_prefixed)
 	{
-		fmt::wmemory_buffer result;
-		result.clear();
+		std::vector<unsigned char> result;
+		append_serialized(result, length_prefixed);
 
-		fmt::format_to(std::back_inserter(result), L"[{},{},{}];", name(), convert_value_type(_type), to_string(false));
+		return result;
+	}
 
-		for (auto& unit : _units)
+	void value::append_serialized(std::wstring& target, const bool& length_prefixed)
+	{
+		// a value outside a shared_ptr cannot link its units, so a change to one of them would never reach its cache
+		if (_parent.lock() != nullptr || weak_from_this().expired())
+		{
+			append_tree(target, length_prefixed);
+			return;
+		}
+
+		_cache.append(target, length_prefixed, [this, &length_prefixed](std::wstring& text) { link_units(); append_tree(text, length_prefixed); });
+	}
+
+	void value::append_serialized(std::vector<unsigned char>& target, const bool& length_prefixed)
+	{
+		if (_parent.lock() != nullptr || weak_from_this().expired())
 		{
-			fmt::format_to(std::back_inserter(result), L"{}", unit->serialize());
+			std::wstring text;
+			append_tree(text, length_prefixed);
+
+			std::vector<unsigned char> fragment = converter::to_array(text);
+			target.insert(target.end(), fragment.begin(), fragment.end());
+			return;
 		}
 
-		return result.data();
+		_cache.append(target, length_prefixed, [this, &length_prefixed](std::wstring& text) { link_units(); append_tree(text, length_prefixed); });
 	}
 
 	std::shared_ptr<value> value::operator[](const std::wstring& key)
 	{
-		std::vector<std::shared_ptr<value>> searched_values = value_array(key);
-		if (searched_values.empty())
+		std::shared_ptr<value> searched_value = find_value(key);
+		if (searched_value == nullptr)
 		{
 			return std::make_shared<value>(key);
 		}
 
-		return searched_values[0];
+		return searched_value;
 	}
 
 	std::shared_ptr<value> operator<<(std::shared_ptr<value> container, std::shared_ptr<value> other)
@@ -348,28 +483,100 @@ namespace container
 		return out;
 	}
 
-	std::shared_ptr<value> value::generate_value(const std::wstring& target_name, const std::wstring& target_type, const std::wstring& target_value)
+	template <typename T, typename... Args> std::shared_ptr<value> create_value(std::shared_ptr<value_arena> arena, Args&&... args)
 	{
+		if (arena == nullptr)
+		{
+			return std::make_shared<T>(std::forward<Args>(args)...);
+		}
+
+		return std::allocate_shared<T>(arena_allocator<T>(arena), std::forward<Args>(args)...);
+	}
+
+	std::string unescape_string(const std::wstring& escaped)
+	{
+		std::string temp = converter::to_string(escaped);
+
+		return string_value::unescape(temp.data(), temp.size());
+	}
+
+	std::shared_ptr<value> value::generate_value(const std::wstring& target_name, const std::wstring& target_type, const std::wstring& target_value, std::shared_ptr<value_arena> arena)
+	{
+		if (target_type == LENGTH_PREFIXED_STRING)
+		{
+			return create_value<string_value>(arena, target_name, target_value);
+		}
+
 		std::shared_ptr<value> result = nullptr;
 		value_types current_type = convert_value_type(target_type);
 
 		switch (current_type)
 		{
-		case value_types::bool_value: result = std::make_shared<bool_value>(target_name, target_value); break;
-		case value_types::short_value: result = std::make_shared<short_value>(target_name, (short)_wtoi(target_value.c_str())); break;
-		case value_types::ushort_value: result = std::make_shared<ushort_value>(target_name, (unsigned short)_wtoi(target_value.c_str())); break;
-		case value_types::int_value: result = std::make_shared<int_value>(target_name, (int)_wtoi(target_value.c_str())); break;
-		case value_types::uint_value: result = std::make_shared<uint_value>(target_name, (unsigned int)_wtoi(target_value.c_str())); break;
-		case value_types::long_value: result = std::make_shared<long_value>(target_name, (long)_wtol(target_value.c_str())); break;
-		case value_types::ulong_value: result = std::make_shared<ulong_value>(target_name, (unsigned long)_wtol(target_value.c_str())); break;
-		case value_types::llong_value: result = std::make_shared<llong_value>(target_name, (long long)_wtoll(target_value.c_str())); break;
-		case value_types::ullong_value: result = std::make_shared<ullong_value>(target_name, (unsigned long long)_wtoll(target_value.c_str())); break;
-		case value_types::float_value: result = std::make_shared<float_value>(target_name, (float)_wtof(target_value.c_str())); break;
-		case value_types::double_value: result = std::make_shared<double_value>(target_name, (double)_wtof(target_value.c_str())); break;
-		case value_types::bytes_value: result = std::make_shared<bytes_value>(target_name, converter::from_base64(target_value.c_str())); break;
-		case value_types::string_value: result = std::make_shared<string_value>(target_name, target_value); break;
-		case value_types::container_value: result = std::make_shared<container_value>(target_name, (long)_wtol(target_value.c_str())); break;
-		default: result = std::make_shared<value>(target_name, nullptr, 0, value_types::null_value); break;
+		case value_types::bool_value: result = create_value<bool_value>(arena, target_name, target_value); break;
+		case value_types::short_value: result = create_value<short_value>(arena, target_name, (short)_wtoi(target_value.c_str())); break;
+		case value_types::ushort_value: result = create_value<ushort_value>(arena, target_name, (unsigned short)_wtoi(target_value.c_str())); break;
+		case value_types::int_value: result = create_value<int_value>(arena, target_name, (int)_wtoi(target_value.c_str())); break;
+		case value_types::uint_value: result = create_value<uint_value>(arena, target_name, (unsigned int)_wtoi(target_value.c_str())); break;
+		case value_types::long_value: result = create_value<long_value>(arena, target_name, (long)_wtol(target_value.c_str())); break;
+		case value_types::ulong_value: result = create_value<ulong_value>(arena, target_name, (unsigned long)_wtol(target_value.c_str())); break;
+		case value_types::llong_value: result = create_value<llong_value>(arena, target_name, (long long)_wtoll(target_value.c_str())); break;
+		case value_types::ullong_value: result = create_value<ullong_value>(arena, target_name, (unsigned long long)_wtoll(target_value.c_str())); break;
+		case value_types::float_value: result = create_value<float_value>(arena, target_name, (float)_wtof(target_value.c_str())); break;
+		case value_types::double_value: result = create_value<double_value>(arena, target_name, (double)_wtof(target_value.c_str())); break;
+		case value_types::bytes_value: result = create_value<bytes_value>(arena, target_name, converter::from_base64(target_value)); break;
+		case value_types::string_value: result = create_value<string_value>(arena, target_name, unescape_string(target_value)); break;
+		case value_types::container_value: result = create_value<container_value>(arena, target_name, (long)_wtol(target_value.c_str())); break;
+		case value_types::int_array_value: result = create_value<int_array_value>(arena); result->set_data(target_name, current_type, target_value); break;
+		case value_types::llong_array_value: result = create_value<llong_array_value>(arena); result->set_data(target_name, current_type, target_value); break;
+		case value_types::float_array_value: result = create_value<float_array_value>(arena); result->set_data(target_name, current_type, target_value); break;
+		case value_types::double_array_value: result = create_value<double_array_value>(arena); result->set_data(target_name, current_type, target_value); break;
+		default: result = create_value<value>(arena, target_name, nullptr, 0, value_types::null_value); break;
+		}
+
+		return result;
+	}
+
+	std::shared_ptr<value> value::copy(std::shared_ptr<value_arena> arena) const
+	{
+		std::shared_ptr<value> result = nullptr;
+
+		switch (_type)
+		{
+		case value_types::bool_value: result = create_value<bool_value>(arena); break;
+		case value_types::short_value: result = create_value<short_value>(arena); break;
+		case value_types::ushort_value: result = create_value<ushort_value>(arena); break;
+		case value_types::int_value: result = create_value<int_value>(arena); break;
+		case value_types::uint_value: result = create_value<uint_value>(arena); break;
+		case value_types::long_value: result = create_value<long_value>(arena); break;
+		case value_types::ulong_value: result = create_value<ulong_value>(arena); break;
+		case value_types::llong_value: result = create_value<llong_value>(arena); break;
+		case value_types::ullong_value: result = create_value<ullong_value>(arena); break;
+		case value_types::float_value: result = create_value<float_value>(arena); break;
+		case value_types::double_value: result = create_value<double_value>(arena); break;
+		case value_types::bytes_value: result = create_value<bytes_value>(arena); break;
+		case value_types::string_value: result = create_value<string_value>(arena); break;
+		case value_types::container_value: result = create_value<container_value>(arena); break;
+		case value_types::int_array_value: result = create_value<int_array_value>(arena); break;
+		case value_types::llong_array_value: result = create_value<llong_array_value>(arena); break;
+		case value_types::float_array_value: result = create_value<float_array_value>(arena); break;
+		case value_types::double_array_value: result = create_value<double_array_value>(arena); break;
+		default: result = create_value<value>(arena); break;
+		}
+
+		result->_name = _name;
+		result->_type = _type;
+		result->_size = _size;
+		result->_numeric = _numeric;
+		result->_data = _data;
+		result->_cache = _cache;
+
+		result->_units.reserve(_units.size());
+		for (auto& unit : _units)
+		{
+			std::shared_ptr<value> child = unit->copy(arena);
+			child->_parent = result;
+			child->_owner_index = result->_index.tracker();
+			result->_units.push_back(child);
 		}
 
 		return result;
@@ -377,14 +584,18 @@ namespace container
 
 	template <typename T> void value::set_data(T data)
 	{
-		char* data_ptr = (char*)&data;
+		invalidate();
 
 		_size = sizeof(T);
-		_data = std::vector<unsigned char>(data_ptr, data_ptr + _size);
+		_numeric.ullong_data = 0;
+		memcpy(_numeric.bytes, &data, _size);
+		_data.clear();
 	}
 
 	void value::set_byte_string(const std::wstring& data)
 	{
+		invalidate();
+
 		_data = converter::from_base64(data);
 		_size = _data.size();
 		_type = value_types::bytes_value;
@@ -392,6 +603,8 @@ namespace container
 
 	void value::set_string(const std::wstring& data)
 	{
+		invalidate();
+
 		_data = converter::to_array(data);
 		_size = _data.size();
 		_type = value_types::string_value;
@@ -402,4 +615,174 @@ namespace container
 		set_data((data == L"true") ? true : false);
 		_type = value_types::bool_value;
 	}
+
+	void value::append_record(std::wstring& target, const bool& length_prefixed)
+	{
+		if (length_prefixed && _type == value_types::string_value)
+		{
+			// the original text is written as is behind its UTF-8 byte length, so no escaping is needed
+			std::wstring temp = to_string();
+			fmt::format_to(std::back_inserter(target), L"[{},{},{}:{}];", name(), LENGTH_PREFIXED_STRING, converter::utf8_length(temp), temp);
+		}
+		else if (_type == value_types::bytes_value || is_array())
+		{
+			// encoded straight into the output buffer instead of through a temporary string
+			fmt::format_to(std::back_inserter(target), L"[{},{},", name(), convert_value_type(_type));
+			size_t offset = target.size();
+			target.resize(offset + converter::base64_length(_data.size()));
+			converter::to_base64(_data.data(), _data.size(), &target[offset]);
+			fmt::format_to(std::back_inserter(target), L"{}", L"];");
+		}
+		else
+		{
+			fmt::format_to(std::back_inserter(target), L"[{},{},{}];", name(), convert_value_type(_type), to_string(false));
+		}
+	}
+
+	void value::append_tree(std::wstring& target, const bool& length_prefixed)
+	{
+		// only the root keeps a cache, so the whole tree is written into its buffer in record order
+		std::vector<value*> pending = { this };
+		while (!pending.empty())
+		{
+			value* current = pending.back();
+			pending.pop_back();
+
+			current->append_record(target, length_prefixed);
+			for (auto unit = current->_units.rbegin(); unit != current->_units.rend(); ++unit)
+			{
+				pending.push_back(unit->get());
+			}
+		}
+	}
+
+	void value::link_units(void)
+	{
+		// a value built from a list of units cannot link them in its constructor, so they are linked once it is attached or cached
+		for (auto& unit : _units)
+		{
+			if (unit->_parent.lock().get() != this)
+			{
+				unit->set_parent(get_ptr());
+			}
+		}
+	}
+
+	void value::invalidate(void)
+	{
+		_cache.reset();
+
+		std::shared_ptr<value> parent = _parent.lock();
+		if (parent != nullptr)
+		{
+			parent->invalidate();
+		}
+	}
+
+	void value::append_xml_text(std::wstring& target, const std::wstring& source)
+	{
+		size_t start = 0;
+		for (size_t index = 0; index < source.size(); ++index)
+		{
+			const wchar_t* entity = nullptr;
+			switch (source[index])
+			{
+			case L'&': entity = L"&amp;"; break;
+			case L'<': entity = L"&lt;"; break;
+			case L'>': entity = L"&gt;"; break;
+			case L'"': entity = L"&quot;"; break;
+			case L'\'': entity = L"&apos;"; break;
+			default: continue;
+			}
+
+			target.append(source, start, index - start);
+			target.append(entity);
+			start = index + 1;
+		}
+
+		target.append(source, start, source.size() - start);
+	}
+
+	void value::append_json_text(std::wstring& target, const std::wstring& source)
+	{
+		size_t start = 0;
+		for (size_t index = 0; index < source.size(); ++index)
+		{
+			wchar_t character = source[index];
+			if (character != L'"' && character != L'\\' && character >= 0x20)
+			{
+				continue;
+			}
+
+			target.append(source, start, index - start);
+			start = index + 1;
+
+			switch (character)
+			{
+			case L'"': target.append(L"\\\""); break;
+			case L'\\': target.append(L"\\\\"); break;
+			case L'\b': target.append(L"\\b"); break;
+			case L'\f': target.append(L"\\f"); break;
+			case L'\n': target.append(L"\\n"); break;
+			case L'\r': target.append(L"\\r"); break;
+			case L'\t': target.append(L"\\t"); break;
+			default: fmt::format_to(std::back_inserter(target), L"\\u{:04x}", static_cast<unsigned int>(character)); break;
+			}
+		}
+
+		target.append(source, start, source.size() - start);
+	}
+
+	void value::append_json_data(std::wstring& target) const
+	{
+		switch (_type)
+		{
+		case value_types::null_value:
+			target.append(L"null");
+			break;
+		case value_types::bool_value:
+		case value_types::short_value:
+		case value_types::ushort_value:
+		case value_types::int_value:
+		case value_types::uint_value:
+		case value_types::long_value:
+		case value_types::ulong_value:
+		case value_types::llong_value:
+		case value_types::ullong_value:
+			target.append(to_string());
+			break;
+		case value_types::float_value:
+		case value_types::double_value:
+			// JSON has no literal for infinity or NaN
+			target.append(std::isfinite(to_double()) ? to_string() : L"null");
+			break;
+		default:
+			target.push_back(L'"');
+			append_json_text(target, to_string());
+			target.push_back(L'"');
+			break;
+		}
+	}
+
+	bool value::is_inline_type(const value_types& type)
+	{
+		switch (type)
+		{
+		case value_types::bool_value:
+		case value_types::short_value:
+		case value_types::ushort_value:
+		case value_types::int_value:
+		case value_types::uint_value:
+		case value_types::long_value:
+		case value_types::ulong_value:
+		case value_types::llong_value:
+		case value_types::ullong_value:
+		case value_types::float_value:
+		case value_types::double_value:
+		case value_types::container_value:
+			return true;
+		default:
+			return false;
+		}
+	}
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "value_types.h"
+#include "value_arena.h"
+#include "value_index.h"
+#include "value_cache.h"
 
 #include <string>
 #include <vector>
@@ -21,14 +24,16 @@ namespace container
 
 	public:
 		std::shared_ptr<value> get_ptr(void);
+		std::shared_ptr<value> copy(std::shared_ptr<value_arena> arena = nullptr) const;
 
 	public:
 		void set_parent(std::shared_ptr<value> parent);
+		void set_owner_index(const value_index& owner_index);
 		void set_data(const unsigned char* data, const size_t& size, const value_types& type);
 		void set_data(const std::wstring& name, const value_types& type, const std::wstring& data);
 
 	public:
-		std::wstring name(void) const;
+		const std::wstring& name(void) const;
 		value_types type(void) const;
 		std::wstring data(void) const;
 		size_t size(void) const;
@@ -45,6 +50,8 @@ namespace container
 		virtual void remove(std::shared_ptr<value> item, const bool& update_count = true) { throw std::exception("cannot support to remove value object on this object"); }
 		virtual void remove_all(void) { throw std::exception("cannot support to remove value object on this object"); }
 		std::vector<std::shared_ptr<value>> value_array(const std::wstring& key);
+		std::shared_ptr<value> find_value(const std::wstring& key, const unsigned int& index = 0);
+		size_t value_count(const std::wstring& key);
 
 	public:
 		const std::vector<unsigned char> to_bytes(void) const;
@@ -56,13 +63,21 @@ namespace container
 		bool is_numeric(void) const;
 		bool is_string(void) const;
 		bool is_container(void) const;
+		bool is_array(void) const;
 
 	public:
 		const std::wstring to_xml(void);
 		const std::wstring to_json(void);
+		void append_xml(std::wstring& target);
+		void append_json(std::wstring& target);
 
 	public:
-		const std::wstring serialize(void);
+		// a value without a parent keeps its serialized form until it or one of its children changes;
+		// concurrent serialization is safe, mutating a value while another thread serializes it is not
+		const std::wstring serialize(const bool& length_prefixed = false);
+		const std::vector<unsigned char> serialize_array(const bool& length_prefixed = false);
+		void append_serialized(std::wstring& target, const bool& length_prefixed = false);
+		void append_serialized(std::vector<unsigned char>& target, const bool& length_prefixed = false);
 
 	public:
 		virtual bool to_boolean(void) const { return false; }
@@ -77,6 +92,7 @@ namespace container
 		virtual float to_float(void) const { return 0.0; }
 		virtual double to_double(void) const { return 0.0; }
 		virtual std::wstring to_string(const bool& original = true) const { return L""; }
+		virtual std::string to_utf8(const bool& original = true) const;
 
 	public:
 		std::shared_ptr<value> operator[](const std::wstring& key);
@@ -90,22 +106,53 @@ namespace container
 		friend std::wstring& operator<<(std::wstring& out, std::shared_ptr<value> other);
 
 	public:
-		static std::shared_ptr<value> generate_value(const std::wstring& name, const std::wstring& type, const std::wstring& value);
+		static std::shared_ptr<value> generate_value(const std::wstring& name, const std::wstring& type, const std::wstring& value, std::shared_ptr<value_arena> arena = nullptr);
+		static void append_xml_text(std::wstring& target, const std::wstring& source);
+		static void append_json_text(std::wstring& target, const std::wstring& source);
 
 	protected:
 		template <typename T> void set_data(T data);
 		void set_byte_string(const std::wstring& data);
 		void set_string(const std::wstring& data);
 		void set_boolean(const std::wstring& data);
+		static bool is_inline_type(const value_types& type);
+		void append_record(std::wstring& target, const bool& length_prefixed);
+		void append_tree(std::wstring& target, const bool& length_prefixed);
+		void link_units(void);
+		void append_json_data(std::wstring& target) const;
+		void invalidate(void);
+
+	protected:
+		union numeric_storage
+		{
+			bool bool_data;
+			short short_data;
+			unsigned short ushort_data;
+			int int_data;
+			unsigned int uint_data;
+			long long_data;
+			unsigned long ulong_data;
+			long long llong_data;
+			unsigned long long ullong_data;
+			float float_data;
+			double double_data;
+			unsigned char bytes[sizeof(unsigned long long)];
+		};
 
 	protected:
 		size_t _size;
 		value_types _type;
 		std::wstring _name;
+		numeric_storage _numeric;
 		std::vector<unsigned char> _data;
 
 	protected:
 		std::weak_ptr<value> _parent;
+		std::weak_ptr<std::atomic<bool>> _owner_index;
 		std::vector<std::shared_ptr<value>> _units;
+		value_index _index;
+
+	protected:
+		value_cache _cache;
 	};
 }
@@ -0,0 +1,29 @@
+#include "value_arena.h"
+
+namespace container
+{
+	value_arena::value_arena(const size_t& block_size)
+		: _allocated_size(0), _resource(block_size)
+	{
+	}
+
+	value_arena::~value_arena(void)
+	{
+	}
+
+	void* value_arena::allocate(const size_t& size, const size_t& alignment)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		_allocated_size += size;
+
+		return _resource.allocate(size, alignment);
+	}
+
+	size_t value_arena::allocated_size(void) const
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		return _allocated_size;
+	}
+}
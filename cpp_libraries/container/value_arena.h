@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <memory_resource>
+
+namespace container
+{
+	class value_arena
+	{
+	public:
+		value_arena(const size_t& block_size = 16384);
+		~value_arena(void);
+
+	public:
+		void* allocate(const size_t& size, const size_t& alignment);
+		size_t allocated_size(void) const;
+
+	private:
+		mutable std::mutex _mutex;
+		size_t _allocated_size;
+		std::pmr::monotonic_buffer_resource _resource;
+	};
+
+	template <typename T> class arena_allocator
+	{
+	public:
+		using value_type = T;
+
+	public:
+		arena_allocator(std::shared_ptr<value_arena> arena) : _arena(arena) {}
+		template <typename U> arena_allocator(const arena_allocator<U>& other) : _arena(other.arena()) {}
+
+	public:
+		T* allocate(const size_t& count) { return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T))); }
+		void deallocate(T*, const size_t&) {}
+
+	public:
+		std::shared_ptr<value_arena> arena(void) const { return _arena; }
+
+		template <typename U> bool operator==(const arena_allocator<U>& other) const { return _arena == other.arena(); }
+		template <typename U> bool operator!=(const arena_allocator<U>& other) const { return _arena != other.arena(); }
+
+	private:
+		std::shared_ptr<value_arena> _arena;
+	};
+}
@@ -0,0 +1,87 @@
+#include "value_cache.h"
+
+#include "converting.h"
+
+namespace container
+{
+	using namespace converting;
+
+	value_cache::value_cache(void)
+		: _length_prefixed(false)
+	{
+	}
+
+	value_cache::value_cache(const value_cache& other)
+		: _length_prefixed(false)
+	{
+		*this = other;
+	}
+
+	value_cache::~value_cache(void)
+	{
+	}
+
+	value_cache& value_cache::operator=(const value_cache& other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		std::scoped_lock<std::mutex, std::mutex> guard(_mutex, other._mutex);
+
+		_length_prefixed = other._length_prefixed;
+		_text = other._text;
+		_bytes = other._bytes;
+
+		return *this;
+	}
+
+	void value_cache::reset(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		_text.clear();
+		_bytes.clear();
+	}
+
+	void value_cache::append(std::wstring& target, const bool& length_prefixed, const std::function<void(std::wstring&)>& build)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		select(length_prefixed);
+		if (_text.empty())
+		{
+			build(_text);
+		}
+
+		target.append(_text);
+	}
+
+	void value_cache::append(std::vector<unsigned char>& target, const bool& length_prefixed, const std::function<void(std::wstring&)>& build)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		select(length_prefixed);
+		if (_bytes.empty())
+		{
+			std::wstring text;
+			build(text);
+			_bytes = converter::to_array(text);
+		}
+
+		target.insert(target.end(), _bytes.begin(), _bytes.end());
+	}
+
+	void value_cache::select(const bool& length_prefixed)
+	{
+		if (_length_prefixed == length_prefixed)
+		{
+			return;
+		}
+
+		_text.clear();
+		_bytes.clear();
+		_length_prefixed = length_prefixed;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace container
+{
+	class value_cache
+	{
+	public:
+		value_cache(void);
+		value_cache(const value_cache& other);
+		~value_cache(void);
+
+	public:
+		value_cache& operator=(const value_cache& other);
+
+	public:
+		void reset(void);
+		void append(std::wstring& target, const bool& length_prefixed, const std::function<void(std::wstring&)>& build);
+		void append(std::vector<unsigned char>& target, const bool& length_prefixed, const std::function<void(std::wstring&)>& build);
+
+	protected:
+		void select(const bool& length_prefixed);
+
+	private:
+		mutable std::mutex _mutex;
+		bool _length_prefixed;
+		std::wstring _text;
+		std::vector<unsigned char> _bytes;
+	};
+}
@@ -0,0 +1,162 @@
+#include "value_index.h"
+
+#include "value.h"
+
+namespace container
+{
+	constexpr size_t INDEX_THRESHOLD = 16;
+
+	value_index::value_index(void)
+		: _stale(std::make_shared<std::atomic<bool>>(false)), _positions(nullptr)
+	{
+	}
+
+	value_index::value_index(const value_index&)
+		: _stale(std::make_shared<std::atomic<bool>>(false)), _positions(nullptr)
+	{
+	}
+
+	value_index::~value_index(void)
+	{
+	}
+
+	value_index& value_index::operator=(const value_index&)
+	{
+		reset();
+
+		return *this;
+	}
+
+	void value_index::reset(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		_positions.reset();
+	}
+
+	std::weak_ptr<std::atomic<bool>> value_index::tracker(void) const
+	{
+		// a unit renamed in place raises this flag, since it cannot reach the owner that indexed it
+		return _stale;
+	}
+
+	std::shared_ptr<value> value_index::find(const std::vector<std::shared_ptr<value>>& units, const std::wstring& name, const unsigned int& index)
+	{
+		if (units.size() < INDEX_THRESHOLD)
+		{
+			unsigned int matched = 0;
+			for (auto& unit : units)
+			{
+				if (unit->name() != name)
+				{
+					continue;
+				}
+
+				if (matched++ == index)
+				{
+					return unit;
+				}
+			}
+
+			return nullptr;
+		}
+
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		const std::vector<size_t>* targets = positions(units, name);
+		if (targets == nullptr || index >= targets->size())
+		{
+			return nullptr;
+		}
+
+		return units[(*targets)[index]];
+	}
+
+	size_t value_index::count(const std::vector<std::shared_ptr<value>>& units, const std::wstring& name)
+	{
+		if (units.size() < INDEX_THRESHOLD)
+		{
+			size_t matched = 0;
+			for (auto& unit : units)
+			{
+				if (unit->name() == name)
+				{
+					++matched;
+				}
+			}
+
+			return matched;
+		}
+
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		const std::vector<size_t>* targets = positions(units, name);
+		if (targets == nullptr)
+		{
+			return 0;
+		}
+
+		return targets->size();
+	}
+
+	std::vector<std::shared_ptr<value>> value_index::collect(const std::vector<std::shared_ptr<value>>& units, const std::wstring& name)
+	{
+		std::vector<std::shared_ptr<value>> result_list;
+
+		if (units.size() < INDEX_THRESHOLD)
+		{
+			for (auto& unit : units)
+			{
+				if (unit->name() == name)
+				{
+					result_list.push_back(unit);
+				}
+			}
+
+			return result_list;
+		}
+
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		const std::vector<size_t>* targets = positions(units, name);
+		if (targets == nullptr)
+		{
+			return result_list;
+		}
+
+		result_list.reserve(targets->size());
+		for (auto& target : *targets)
+		{
+			result_list.push_back(units[target]);
+		}
+
+		return result_list;
+	}
+
+	const std::vector<size_t>* value_index::positions(const std::vector<std::shared_ptr<value>>& units, const std::wstring& name)
+	{
+		if (_stale->exchange(false))
+		{
+			_positions.reset();
+		}
+
+		if (_positions == nullptr)
+		{
+			_positions = std::make_unique<std::unordered_map<std::wstring, std::vector<size_t>>>();
+			_positions->reserve(units.size());
+
+			for (size_t index = 0; index < units.size(); ++index)
+			{
+				(*_positions)[units[index]->name()].push_back(index);
+			}
+		}
+
+		auto target = _positions->find(name);
+		if (target == _positions->end())
+		{
+			return nullptr;
+		}
+
+		return &target->second;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace container
+{
+	class value;
+
+	class value_index
+	{
+	public:
+		value_index(void);
+		value_index(const value_index& other);
+		~value_index(void);
+
+	public:
+		value_index& operator=(const value_index& other);
+
+	public:
+		void reset(void);
+		std::weak_ptr<std::atomic<bool>> tracker(void) const;
+		std::shared_ptr<value> find(const std::vector<std::shared_ptr<value>>& units, const std::wstring& name, const unsigned int& index = 0);
+		size_t count(const std::vector<std::shared_ptr<value>>& units, const std::wstring& name);
+		std::vector<std::shared_ptr<value>> collect(const std::vector<std::shared_ptr<value>>& units, const std::wstring& name);
+
+	protected:
+		// the caller holds _mutex
+		const std::vector<size_t>* positions(const std::vector<std::shared_ptr<value>>& units, const std::wstring& name);
+
+	private:
+		std::mutex _mutex;
+		std::shared_ptr<std::atomic<bool>> _stale;
+		std::unique_ptr<std::unordered_map<std::wstring, std::vector<size_t>>> _positions;
+	};
+}
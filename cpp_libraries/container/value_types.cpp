@@ -19,7 +19,12 @@ namespace container
 		{ L"b", value_types::double_value },
 		{ L"c", value_types::bytes_value },
 		{ L"d", value_types::string_value },
-		{ L"e", value_types::container_value }
+		{ L"e", value_types::container_value },
+		{ L"g", value_types::int_array_value },
+		{ L"h", value_types::llong_array_value },
+		{ L"i", value_types::float_array_value },
+		{ L"j", value_types::double_array_value },
+		{ LENGTH_PREFIXED_STRING, value_types::string_value }
 	};
 
 	const value_types convert_value_type(const std::wstring& target)
@@ -53,6 +58,10 @@ namespace container
 		case value_types::bytes_value: result = L"c"; break;
 		case value_types::string_value: result = L"d"; break;
 		case value_types::container_value: result = L"e"; break;
+		case value_types::int_array_value: result = L"g"; break;
+		case value_types::llong_array_value: result = L"h"; break;
+		case value_types::float_array_value: result = L"i"; break;
+		case value_types::double_array_value: result = L"j"; break;
 		default: result = L"0"; break;
 		}
 
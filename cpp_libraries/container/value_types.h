@@ -20,9 +20,15 @@ namespace container
 		double_value,
 		bytes_value,
 		string_value,
-		container_value
+		container_value,
+		int_array_value,
+		llong_array_value,
+		float_array_value,
+		double_array_value
 	};
 
+	constexpr auto LENGTH_PREFIXED_STRING = L"f";
+
 	const value_types convert_value_type(const std::wstring& target);
 	const std::wstring convert_value_type(const value_types& target);
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "array_value.h"
+
+#include "converting.h"
+
+namespace container
+{
+	using namespace converting;
+
+	template <typename T, value_types array_type>
+	array_value<T, array_type>::array_value(void)
+		: value()
+	{
+		_type = array_type;
+	}
+
+	template <typename T, value_types array_type>
+	array_value<T, array_type>::array_value(const std::wstring& name, const std::vector<T>& values)
+		: array_value(name, values.data(), values.size())
+	{
+	}
+
+	template <typename T, value_types array_type>
+	array_value<T, array_type>::array_value(const std::wstring& name, const T* values, const size_t& count)
+		: value()
+	{
+		_name = name;
+		set_values(values, count);
+	}
+
+	template <typename T, value_types array_type>
+	array_value<T, array_type>::~array_value(void)
+	{
+	}
+
+	template <typename T, value_types array_type>
+	void array_value<T, array_type>::set_values(const T* values, const size_t& count)
+	{
+		invalidate();
+
+		_type = array_type;
+		if (values == nullptr || count == 0)
+		{
+			_size = 0;
+			_data.clear();
+			return;
+		}
+
+		const unsigned char* source = reinterpret_cast<const unsigned char*>(values);
+		_data.assign(source, source + count * sizeof(T));
+		_size = _data.size();
+	}
+
+	template <typename T, value_types array_type>
+	const T* array_value<T, array_type>::begin(void) const
+	{
+		return reinterpret_cast<const T*>(_data.data());
+	}
+
+	template <typename T, value_types array_type>
+	const T* array_value<T, array_type>::end(void) const
+	{
+		return begin() + count();
+	}
+
+	template <typename T, value_types array_type>
+	size_t array_value<T, array_type>::count(void) const
+	{
+		return _data.size() / sizeof(T);
+	}
+
+	template <typename T, value_types array_type>
+	T array_value<T, array_type>::at(const size_t& index) const
+	{
+		if (index >= count())
+		{
+			throw std::out_of_range("array index is out of range");
+		}
+
+		return begin()[index];
+	}
+
+	template <typename T, value_types array_type>
+	std::vector<T> array_value<T, array_type>::to_vector(void) const
+	{
+		return std::vector<T>(begin(), end());
+	}
+
+	template <typename T, value_types array_type>
+	std::wstring array_value<T, array_type>::to_string(const bool&) const
+	{
+		return converter::to_base64(_data);
+	}
+
+	template class array_value<int, value_types::int_array_value>;
+	template class array_value<long long, value_types::llong_array_value>;
+	template class array_value<float, value_types::float_array_value>;
+	template class array_value<double, value_types::double_array_value>;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../value.h"
+
+namespace container
+{
+	template <typename T, value_types array_type>
+	class array_value : public value
+	{
+	public:
+		array_value(void);
+		array_value(const std::wstring& name, const std::vector<T>& values);
+		array_value(const std::wstring& name, const T* values, const size_t& count);
+		~array_value(void);
+
+	public:
+		void set_values(const T* values, const size_t& count);
+
+	public:
+		const T* begin(void) const;
+		const T* end(void) const;
+		size_t count(void) const;
+		T at(const size_t& index) const;
+		std::vector<T> to_vector(void) const;
+
+	public:
+		std::wstring to_string(const bool& original = true) const override;
+	};
+
+	using int_array_value = array_value<int, value_types::int_array_value>;
+	using llong_array_value = array_value<long long, value_types::llong_array_value>;
+	using float_array_value = array_value<float, value_types::float_array_value>;
+	using double_array_value = array_value<double, value_types::double_array_value>;
+}
@@ -24,90 +24,57 @@ namespace container
 
 	bool bool_value::to_boolean(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return temp;
+		return _numeric.bool_data;
 	}
 
 	short bool_value::to_short(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.bool_data);
 	}
 
 	unsigned short bool_value::to_ushort(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.bool_data);
 	}
 
 	int bool_value::to_int(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.bool_data);
 	}
 
 	unsigned int bool_value::to_uint(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.bool_data);
 	}
 
 	long bool_value::to_long(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.bool_data);
 	}
 
 	unsigned long bool_value::to_ulong(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.bool_data);
 	}
 
 	long long bool_value::to_llong(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.bool_data);
 	}
 
 	unsigned long long bool_value::to_ullong(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.bool_data);
 	}
 
 	float bool_value::to_float(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.bool_data);
 	}
 
 	double bool_value::to_double(void) const
 	{
-		bool temp = false;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.bool_data);
 	}
 
 	std::wstring bool_value::to_string(const bool&) const
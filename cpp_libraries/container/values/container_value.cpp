@@ -18,9 +18,7 @@ namespace container
 		_name = name;
 		_type = value_types::container_value;
 		_size = sizeof(long);
-
-		char* data_ptr = (char*)&reserved_count;
-		_data = std::vector<unsigned char>(data_ptr, data_ptr + _size);
+		_numeric.long_data = reserved_count;
 	}
 
 	container_value::container_value(const std::wstring& name, const std::vector<std::shared_ptr<value>>& units)
@@ -36,7 +34,7 @@ namespace container
 
 	std::shared_ptr<value> container_value::add(const value& item, const bool& update_count)
 	{
-		return add(value::generate_value(item.name(), convert_value_type(item.type()), item.to_string()), update_count);
+		return add(value::generate_value(item.name(), convert_value_type(item.type()), item.to_string(false)), update_count);
 	}
 
 	std::shared_ptr<value> container_value::add(std::shared_ptr<value> item, const bool& update_count)
@@ -54,6 +52,8 @@ namespace container
 		}
 
 		_units.push_back(item);
+		_index.reset();
+		invalidate();
 		item->set_parent(get_ptr());
 
 		if (update_count == true)
@@ -70,7 +70,7 @@ namespace container
 		std::vector<std::shared_ptr<value>> temp_values;
 		for (auto& target_value : target_values)
 		{
-			temp_values.push_back(value::generate_value(target_value.name(), convert_value_type(target_value.type()), target_value.to_string()));
+			temp_values.push_back(value::generate_value(target_value.name(), convert_value_type(target_value.type()), target_value.to_string(false)));
 		}
 
 		add(temp_values, update_count);
@@ -95,6 +95,8 @@ namespace container
 			_units.push_back(target_value);
 			target_value->set_parent(get_ptr());
 		}
+		_index.reset();
+		invalidate();
 
 		if (update_count == true)
 		{
@@ -121,6 +123,8 @@ namespace container
 
 			_units.erase(target);
 		}
+		_index.reset();
+		invalidate();
 
 		if (update_count == true)
 		{
@@ -144,6 +148,8 @@ namespace container
 		}
 
 		_units.erase(target);
+		_index.reset();
+		invalidate();
 
 		if (update_count == true)
 		{
@@ -155,6 +161,8 @@ namespace container
 	void container_value::remove_all(void)
 	{
 		_units.clear();
+		_index.reset();
+		invalidate();
 
 		long size = static_cast<long>(_units.size());
 		set_data((const unsigned char*)&size, sizeof(long), value_types::container_value);
@@ -162,82 +170,52 @@ namespace container
 
 	short container_value::to_short(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.long_data);
 	}
 
 	unsigned short container_value::to_ushort(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.long_data);
 	}
 
 	int container_value::to_int(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.long_data);
 	}
 
 	unsigned int container_value::to_uint(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.long_data);
 	}
 
 	long container_value::to_long(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.long_data);
 	}
 
 	unsigned long container_value::to_ulong(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.long_data);
 	}
 
 	long long container_value::to_llong(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.long_data);
 	}
 
 	unsigned long long container_value::to_ullong(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.long_data);
 	}
 
 	float container_value::to_float(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.long_data);
 	}
 
 	double container_value::to_double(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.long_data);
 	}
 
 	std::wstring container_value::to_string(const bool&) const
@@ -21,82 +21,52 @@ namespace container
 
 	short double_value::to_short(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.double_data);
 	}
 
 	unsigned short double_value::to_ushort(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.double_data);
 	}
 
 	int double_value::to_int(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.double_data);
 	}
 
 	unsigned int double_value::to_uint(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.double_data);
 	}
 
 	long double_value::to_long(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.double_data);
 	}
 
 	unsigned long double_value::to_ulong(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.double_data);
 	}
 
 	long long double_value::to_llong(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.double_data);
 	}
 
 	unsigned long long double_value::to_ullong(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.double_data);
 	}
 
 	float double_value::to_float(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.double_data);
 	}
 
 	double double_value::to_double(void) const
 	{
-		double temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.double_data);
 	}
 
 	std::wstring double_value::to_string(const bool&) const
@@ -21,82 +21,52 @@ namespace container
 
 	short float_value::to_short(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.float_data);
 	}
 
 	unsigned short float_value::to_ushort(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.float_data);
 	}
 
 	int float_value::to_int(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.float_data);
 	}
 
 	unsigned int float_value::to_uint(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.float_data);
 	}
 
 	long float_value::to_long(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.float_data);
 	}
 
 	unsigned long float_value::to_ulong(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.float_data);
 	}
 
 	long long float_value::to_llong(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.float_data);
 	}
 
 	unsigned long long float_value::to_ullong(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.float_data);
 	}
 
 	float float_value::to_float(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.float_data);
 	}
 
 	double float_value::to_double(void) const
 	{
-		float temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.float_data);
 	}
 
 	std::wstring float_value::to_string(const bool&) const
@@ -21,82 +21,52 @@ namespace container
 
 	short int_value::to_short(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.int_data);
 	}
 
 	unsigned short int_value::to_ushort(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.int_data);
 	}
 
 	int int_value::to_int(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.int_data);
 	}
 
 	unsigned int int_value::to_uint(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.int_data);
 	}
 
 	long int_value::to_long(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.int_data);
 	}
 
 	unsigned long int_value::to_ulong(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.int_data);
 	}
 
 	long long int_value::to_llong(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.int_data);
 	}
 
 	unsigned long long int_value::to_ullong(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.int_data);
 	}
 
 	float int_value::to_float(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.int_data);
 	}
 
 	double int_value::to_double(void) const
 	{
-		int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.int_data);
 	}
 
 	std::wstring int_value::to_string(const bool&) const
@@ -21,82 +21,52 @@ namespace container
 
 	short llong_value::to_short(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.llong_data);
 	}
 
 	unsigned short llong_value::to_ushort(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.llong_data);
 	}
 
 	int llong_value::to_int(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.llong_data);
 	}
 
 	unsigned int llong_value::to_uint(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.llong_data);
 	}
 
 	long llong_value::to_long(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.llong_data);
 	}
 
 	unsigned long llong_value::to_ulong(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.llong_data);
 	}
 
 	long long llong_value::to_llong(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.llong_data);
 	}
 
 	unsigned long long llong_value::to_ullong(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.llong_data);
 	}
 
 	float llong_value::to_float(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.llong_data);
 	}
 
 	double llong_value::to_double(void) const
 	{
-		long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.llong_data);
 	}
 
 	std::wstring llong_value::to_string(const bool&) const
@@ -21,82 +21,52 @@ namespace container
 
 	short long_value::to_short(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.long_data);
 	}
 
 	unsigned short long_value::to_ushort(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.long_data);
 	}
 
 	int long_value::to_int(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.long_data);
 	}
 
 	unsigned int long_value::to_uint(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.long_data);
 	}
 
 	long long_value::to_long(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.long_data);
 	}
 
 	unsigned long long_value::to_ulong(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.long_data);
 	}
 
 	long long long_value::to_llong(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.long_data);
 	}
 
 	unsigned long long long_value::to_ullong(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.long_data);
 	}
 
 	float long_value::to_float(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.long_data);
 	}
 
 	double long_value::to_double(void) const
 	{
-		long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.long_data);
 	}
 
 	std::wstring long_value::to_string(const bool&) const
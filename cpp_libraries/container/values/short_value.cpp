@@ -21,82 +21,52 @@ namespace container
 
 	short short_value::to_short(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.short_data);
 	}
 
 	unsigned short short_value::to_ushort(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.short_data);
 	}
 
 	int short_value::to_int(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.short_data);
 	}
 
 	unsigned int short_value::to_uint(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.short_data);
 	}
 
 	long short_value::to_long(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.short_data);
 	}
 
 	unsigned long short_value::to_ulong(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.short_data);
 	}
 
 	long long short_value::to_llong(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.short_data);
 	}
 
 	unsigned long long short_value::to_ullong(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.short_data);
 	}
 
 	float short_value::to_float(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.short_data);
 	}
 
 	double short_value::to_double(void) const
 	{
-		short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.short_data);
 	}
 
 	std::wstring short_value::to_string(const bool&) const
@@ -2,10 +2,124 @@
 
 #include "converting.h"
 
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define STRING_VALUE_SSE2
+#endif
+
 namespace container
 {
 	using namespace converting;
 
+	namespace
+	{
+		constexpr size_t TOKEN_SIZE = 8;
+
+		const char* escape_token(const char& source)
+		{
+			switch (source)
+			{
+			case '\r': return "</0x0A;>";
+			case '\n': return "</0x0B;>";
+			case ' ': return "</0x0C;>";
+			case '\t': return "</0x0D;>";
+			default: return nullptr;
+			}
+		}
+
+		char unescape_token(const char* data, const size_t& remained)
+		{
+			if (remained < TOKEN_SIZE || memcmp(data, "</0x0", 5) != 0 || data[6] != ';' || data[7] != '>')
+			{
+				return 0;
+			}
+
+			switch (data[5])
+			{
+			case 'A': return '\r';
+			case 'B': return '\n';
+			case 'C': return ' ';
+			case 'D': return '\t';
+			default: return 0;
+			}
+		}
+
+		// returns the offset of the first byte that needs escaping, or size when there is none
+		size_t find_escape(const char* data, const size_t& offset, const size_t& size)
+		{
+			size_t position = offset;
+#ifdef STRING_VALUE_SSE2
+			const __m128i carriage_return = _mm_set1_epi8('\r');
+			const __m128i line_feed = _mm_set1_epi8('\n');
+			const __m128i space = _mm_set1_epi8(' ');
+			const __m128i tab = _mm_set1_epi8('\t');
+
+			for (; position + 16 <= size; position += 16)
+			{
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+				__m128i matched = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, carriage_return), _mm_cmpeq_epi8(block, line_feed)),
+					_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)));
+
+				int mask = _mm_movemask_epi8(matched);
+				if (mask != 0)
+				{
+					unsigned long index = 0;
+					while ((mask & (1 << index)) == 0)
+					{
+						++index;
+					}
+
+					return position + index;
+				}
+			}
+#endif
+			for (; position < size; ++position)
+			{
+				if (escape_token(data[position]) != nullptr)
+				{
+					return position;
+				}
+			}
+
+			return size;
+		}
+
+		// returns the offset of the next '<', or size when there is none
+		size_t find_token(const char* data, const size_t& offset, const size_t& size)
+		{
+			size_t position = offset;
+#ifdef STRING_VALUE_SSE2
+			const __m128i bracket = _mm_set1_epi8('<');
+
+			for (; position + 16 <= size; position += 16)
+			{
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+
+				int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, bracket));
+				if (mask != 0)
+				{
+					unsigned long index = 0;
+					while ((mask & (1 << index)) == 0)
+					{
+						++index;
+					}
+
+					return position + index;
+				}
+			}
+#endif
+			const void* found = memchr(data + position, '<', size - position);
+			if (found == nullptr)
+			{
+				return size;
+			}
+
+			return static_cast<const char*>(found) - data;
+		}
+	}
+
 	string_value::string_value(void)
 		: value()
 	{
@@ -15,34 +129,89 @@ namespace container
 	string_value::string_value(const std::wstring& name, const std::wstring& value)
 		: value(name, nullptr, 0, value_types::null_value)
 	{
-		std::wstring temp = value;
-		converter::replace(temp, L"\r", L"</0x0A;>");
-		converter::replace(temp, L"\n", L"</0x0B;>");
-		converter::replace(temp, L" ", L"</0x0C;>");
-		converter::replace(temp, L"\t", L"</0x0D;>");
-
-		std::vector<unsigned char> data = converter::to_array(temp);
+		std::vector<unsigned char> data = converter::to_array(value);
 
 		set_data(data.data(), data.size(), value_types::string_value);
 	}
 
+	string_value::string_value(const std::wstring& name, const std::string& value)
+		: value(name, (const unsigned char*)value.data(), value.size(), value_types::string_value)
+	{
+	}
+
 	string_value::~string_value(void)
 	{
 	}
 
 	std::wstring string_value::to_string(const bool& original) const
 	{
-		if (!original)
+		if (original)
 		{
 			return converter::to_wstring(_data);
 		}
 
-		std::wstring temp = converter::to_wstring(_data);
-		converter::replace(temp, L"</0x0A;>", L"\r");
-		converter::replace(temp, L"</0x0B;>", L"\n");
-		converter::replace(temp, L"</0x0C;>", L" ");
-		converter::replace(temp, L"</0x0D;>", L"\t");
+		return converter::to_wstring(escape((const char*)_data.data(), _data.size()));
+	}
+
+	std::string string_value::to_utf8(const bool& original) const
+	{
+		if (original)
+		{
+			return converter::to_string(_data);
+		}
+
+		return escape((const char*)_data.data(), _data.size());
+	}
+
+	std::string string_value::escape(const char* data, const size_t& size)
+	{
+		size_t position = find_escape(data, 0, size);
+		if (position == size)
+		{
+			return std::string(data, size);
+		}
+
+		std::string result;
+		result.reserve(size + (size >> 2));
+		result.append(data, position);
+
+		while (position < size)
+		{
+			result.append(escape_token(data[position]), TOKEN_SIZE);
+
+			size_t next = find_escape(data, position + 1, size);
+			result.append(data + position + 1, next - position - 1);
+			position = next;
+		}
+
+		return result;
+	}
+
+	std::string string_value::unescape(const char* data, const size_t& size)
+	{
+		std::string result;
+		result.reserve(size);
+
+		size_t offset = 0;
+		size_t position = find_token(data, 0, size);
+		while (position < size)
+		{
+			char character = unescape_token(data + position, size - position);
+			if (character == 0)
+			{
+				position = find_token(data, position + 1, size);
+				continue;
+			}
+
+			result.append(data + offset, position - offset);
+			result.push_back(character);
+
+			offset = position + TOKEN_SIZE;
+			position = find_token(data, offset, size);
+		}
+
+		result.append(data + offset, size - offset);
 
-		return temp;
+		return result;
 	}
 }
\ No newline at end of file
@@ -9,9 +9,15 @@ namespace container
 	public:
 		string_value(void);
 		string_value(const std::wstring& name, const std::wstring& value);
+		string_value(const std::wstring& name, const std::string& value);
 		~string_value(void);
 
 	public:
 		std::wstring to_string(const bool& original = true) const override;
+		std::string to_utf8(const bool& original = true) const override;
+
+	public:
+		static std::string escape(const char* data, const size_t& size);
+		static std::string unescape(const char* data, const size_t& size);
 	};
 }
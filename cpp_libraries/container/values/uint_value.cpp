@@ -21,82 +21,52 @@ namespace container
 
 	short uint_value::to_short(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.uint_data);
 	}
 
 	unsigned short uint_value::to_ushort(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.uint_data);
 	}
 
 	int uint_value::to_int(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.uint_data);
 	}
 
 	unsigned int uint_value::to_uint(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.uint_data);
 	}
 
 	long uint_value::to_long(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.uint_data);
 	}
 
 	unsigned long uint_value::to_ulong(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.uint_data);
 	}
 
 	long long uint_value::to_llong(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.uint_data);
 	}
 
 	unsigned long long uint_value::to_ullong(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.uint_data);
 	}
 
 	float uint_value::to_float(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.uint_data);
 	}
 
 	double uint_value::to_double(void) const
 	{
-		unsigned int temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.uint_data);
 	}
 
 	std::wstring uint_value::to_string(const bool&) const
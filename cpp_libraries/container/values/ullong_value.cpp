@@ -21,82 +21,52 @@ namespace container
 
 	short ullong_value::to_short(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.ullong_data);
 	}
 
 	unsigned short ullong_value::to_ushort(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.ullong_data);
 	}
 
 	int ullong_value::to_int(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.ullong_data);
 	}
 
 	unsigned int ullong_value::to_uint(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.ullong_data);
 	}
 
 	long ullong_value::to_long(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.ullong_data);
 	}
 
 	unsigned long ullong_value::to_ulong(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.ullong_data);
 	}
 
 	long long ullong_value::to_llong(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.ullong_data);
 	}
 
 	unsigned long long ullong_value::to_ullong(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.ullong_data);
 	}
 
 	float ullong_value::to_float(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.ullong_data);
 	}
 
 	double ullong_value::to_double(void) const
 	{
-		unsigned long long temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.ullong_data);
 	}
 
 	std::wstring ullong_value::to_string(const bool&) const
@@ -21,82 +21,52 @@ namespace container
 
 	short ushort_value::to_short(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<short>(temp);
+		return static_cast<short>(_numeric.ushort_data);
 	}
 
 	unsigned short ushort_value::to_ushort(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned short>(temp);
+		return static_cast<unsigned short>(_numeric.ushort_data);
 	}
 
 	int ushort_value::to_int(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<int>(temp);
+		return static_cast<int>(_numeric.ushort_data);
 	}
 
 	unsigned int ushort_value::to_uint(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned int>(temp);
+		return static_cast<unsigned int>(_numeric.ushort_data);
 	}
 
 	long ushort_value::to_long(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long>(temp);
+		return static_cast<long>(_numeric.ushort_data);
 	}
 
 	unsigned long ushort_value::to_ulong(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long>(temp);
+		return static_cast<unsigned long>(_numeric.ushort_data);
 	}
 
 	long long ushort_value::to_llong(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<long long>(temp);
+		return static_cast<long long>(_numeric.ushort_data);
 	}
 
 	unsigned long long ushort_value::to_ullong(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<unsigned long long>(temp);
+		return static_cast<unsigned long long>(_numeric.ushort_data);
 	}
 
 	float ushort_value::to_float(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<float>(temp);
+		return static_cast<float>(_numeric.ushort_data);
 	}
 
 	double ushort_value::to_double(void) const
 	{
-		unsigned short temp = 0;
-		memcpy(&temp, _data.data(), _size);
-
-		return static_cast<double>(temp);
+		return static_cast<double>(_numeric.ushort_data);
 	}
 
 	std::wstring ushort_value::to_string(const bool&) const
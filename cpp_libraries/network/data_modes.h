@@ -6,6 +6,8 @@ namespace network
 	{
 		binary_mode = 1,
 		packet_mode = 2,
-		file_mode = 3
+		file_mode = 3,
+		batch_mode = 4,
+		stream_mode = 5
 	};
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "event_dispatcher.h"
+
+#include "logging.h"
+
+#include "fmt/format.h"
+
+namespace network
+{
+	using namespace logging;
+
+	event_dispatcher::event_dispatcher(const size_t& capacity)
+		: _capacity(capacity), _overflowed(false)
+	{
+	}
+
+	event_dispatcher::~event_dispatcher(void)
+	{
+		stop();
+	}
+
+	void event_dispatcher::start(void)
+	{
+		stop();
+
+		_thread_stop.store(false);
+
+		// the thread holds the dispatcher, so an owner released from one of its events cannot free it under the running loop
+		std::shared_ptr<event_dispatcher> dispatcher = shared_from_this();
+		_thread = std::thread([dispatcher](void) { dispatcher->run(); });
+	}
+
+	void event_dispatcher::stop(void)
+	{
+		if (!_thread.joinable())
+		{
+			return;
+		}
+
+		bool self_stop = _thread.get_id() == std::this_thread::get_id();
+		std::queue<std::function<void(void)>> dropped;
+
+		std::unique_lock<std::mutex> unique(_mutex);
+		_thread_stop.store(true);
+
+		// an owner stopping from its own event is being torn down, so its pending events must not run afterwards
+		if (self_stop)
+		{
+			dropped.swap(_events);
+		}
+		unique.unlock();
+
+		_condition.notify_one();
+
+		if (self_stop)
+		{
+			_thread.detach();
+
+			return;
+		}
+
+		_thread.join();
+	}
+
+	bool event_dispatcher::push(const std::function<void(void)>& event)
+	{
+		if (event == nullptr || _thread_stop.load())
+		{
+			return false;
+		}
+
+		std::unique_lock<std::mutex> unique(_mutex);
+		if (_thread_stop.load())
+		{
+			return false;
+		}
+
+		// waiting for room would stall every socket on the io thread, and connection events must not be lost, so the queue grows
+		_events.push(event);
+		bool overflowed = !_overflowed && _events.size() > _capacity;
+		if (overflowed)
+		{
+			_overflowed = true;
+		}
+		size_t pending = _events.size();
+		unique.unlock();
+
+		if (overflowed)
+		{
+			logger::handle().write(logging::logging_level::error, fmt::format(L"event dispatcher is behind: {} events pending over a capacity of {}", pending, _capacity));
+		}
+
+		_condition.notify_one();
+
+		return true;
+	}
+
+	size_t event_dispatcher::pending_count(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		return _events.size();
+	}
+
+	void event_dispatcher::run(void)
+	{
+		logger::handle().write(logging::logging_level::sequence, L"start event dispatcher");
+
+		while (true)
+		{
+			std::unique_lock<std::mutex> unique(_mutex);
+			_condition.wait(unique, [this] { return !_events.empty() || _thread_stop.load(); });
+
+			if (_events.empty())
+			{
+				break;
+			}
+
+			std::function<void(void)> event = std::move(_events.front());
+			_events.pop();
+			if (_events.empty())
+			{
+				_overflowed = false;
+			}
+			unique.unlock();
+
+			event();
+		}
+
+		logger::handle().write(logging::logging_level::sequence, L"stop event dispatcher");
+	}
+}
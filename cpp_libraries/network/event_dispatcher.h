@@ -0,0 +1,42 @@
+#pragma once
+
+#include <mutex>
+#include <queue>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+namespace network
+{
+	// push never waits, since it is called from the io thread; the capacity only marks a backlog worth reporting
+	class event_dispatcher : public std::enable_shared_from_this<event_dispatcher>
+	{
+	public:
+		event_dispatcher(const size_t& capacity = 1024);
+		~event_dispatcher(void);
+
+	public:
+		void start(void);
+		void stop(void);
+
+	public:
+		bool push(const std::function<void(void)>& event);
+		size_t pending_count(void);
+
+	protected:
+		void run(void);
+
+	private:
+		size_t _capacity;
+		bool _overflowed;
+		std::atomic<bool> _thread_stop{ true };
+
+	private:
+		std::mutex _mutex;
+		std::thread _thread;
+		std::condition_variable _condition;
+		std::queue<std::function<void(void)>> _events;
+	};
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "message_schema.h"
+
+#include "codec_types.h"
+
+#include <string>
+#include <vector>
+
+namespace network
+{
+	struct request_connection
+	{
+		std::wstring connection_key;
+		bool auto_echo = false;
+		unsigned short auto_echo_interval_seconds = 1;
+		short session_type = 0;
+		bool bridge_mode = false;
+		std::vector<std::wstring> snipping_targets;
+		bool stream_compression = false;
+		unsigned int dictionary_id = 0;
+		unsigned short codec = (unsigned short)compressing::codec_types::lz4;
+		int codec_level = 0;
+		unsigned int codecs = 0;
+
+		static constexpr const wchar_t* message_type = L"request_connection";
+
+		static constexpr auto fields(void)
+		{
+			return std::make_tuple(
+				container::make_field(L"connection_key", &request_connection::connection_key),
+				container::make_field(L"auto_echo", &request_connection::auto_echo),
+				container::make_field(L"auto_echo_interval_seconds", &request_connection::auto_echo_interval_seconds),
+				container::make_field(L"session_type", &request_connection::session_type),
+				container::make_field(L"bridge_mode", &request_connection::bridge_mode),
+				container::make_field(L"snipping_targets", &request_connection::snipping_targets, L"snipping_target"),
+				container::make_field(L"stream_compression", &request_connection::stream_compression),
+				container::make_field(L"dictionary_id", &request_connection::dictionary_id),
+				container::make_field(L"codec", &request_connection::codec),
+				container::make_field(L"codec_level", &request_connection::codec_level),
+				container::make_field(L"codecs", &request_connection::codecs));
+		}
+	};
+
+	struct transfer_condition
+	{
+		std::wstring indication_id;
+		unsigned short percentage = 0;
+		unsigned long long completed_count = 0;
+		unsigned long long failed_count = 0;
+		bool completed = false;
+
+		static constexpr const wchar_t* message_type = L"transfer_condition";
+
+		static constexpr auto fields(void)
+		{
+			return std::make_tuple(
+				container::make_field(L"indication_id", &transfer_condition::indication_id),
+				container::make_field(L"percentage", &transfer_condition::percentage),
+				container::make_field(L"completed_count", &transfer_condition::completed_count),
+				container::make_field(L"failed_count", &transfer_condition::failed_count),
+				container::make_field(L"completed", &transfer_condition::completed));
+		}
+	};
+}
@@ -1,17 +1,17 @@
 ﻿#include "messaging_client.h"
 
+#include "messages.h"
+
 #include "value.h"
 #include "values/bool_value.h"
 #include "values/bytes_value.h"
-#include "values/short_value.h"
-#include "values/ushort_value.h"
 #include "values/string_value.h"
-#include "values/container_value.h"
 
 #include "logging.h"
 #include "converting.h"
 #include "encrypting.h"
 #include "compressing.h"
+#include "codec_registry.h"
 #include "thread_worker.h"
 #include "job_pool.h"
 #include "job.h"
@@ -19,6 +19,9 @@
 #include "data_lengths.h"
 #include "file_handling.h"
 
+#include <limits>
+#include <random>
+#include <algorithm>
 #include <functional>
 
 #include "fmt/format.h"
@@ -37,8 +40,16 @@ namespace network
 		: data_handling(246, 135), _confirm(false), _auto_echo(false), _compress_mode(false), _encrypt_mode(false), _bridge_line(false),
 		_io_context(nullptr), _socket(nullptr), _key(L""), _iv(L""), _thread_pool(nullptr), _auto_echo_interval_seconds(1), _connection(nullptr),
 		_connection_key(L"connection_key"), _source_id(source_id), _source_sub_id(L""), _target_id(L"unknown"), _target_sub_id(L"0.0.0.0:0"), _received_file(nullptr),
-		_received_message(nullptr), _received_data(nullptr), _session_type(session_types::binary_line)
+		_received_message(nullptr), _received_data(nullptr), _session_type(session_types::binary_line),
+		_ip(L""), _port(0), _high_priority(8), _normal_priority(8), _low_priority(8), _auto_reconnect(false), _min_reconnect_delay(500), _max_reconnect_delay(30000),
+		_connect_timeout_seconds(10), _reconnect_attempts(0), _buffer_limit(1024), _connect_timer(nullptr), _reconnect_timer(nullptr), _work_guard(nullptr),
+		_batch_mode(false), _batch_scheduled(false), _batch_window_milliseconds(5), _batch_window_bytes(65536),
+		_stream_compression(false), _codec(codec_types::lz4), _codec_level(0), _stream_compressor(nullptr), _stream_decompressor(nullptr), _event_dispatcher(std::make_shared<event_dispatcher>())
 	{
+		_utf8_source_id = converter::to_string(_source_id);
+
+		_event_dispatcher->start();
+
 		_message_handlers.insert({ L"confirm_connection", std::bind(&messaging_client::confirm_message, this, std::placeholders::_1) });
 		_message_handlers.insert({ L"echo", std::bind(&messaging_client::echo_message, this, std::placeholders::_1) });
 	}
@@ -46,6 +57,8 @@ namespace network
 	messaging_client::~messaging_client(void)
 	{
 		stop();
+
+		_event_dispatcher->stop();
 	}
 
 	std::shared_ptr<messaging_client> messaging_client::get_ptr(void)
@@ -94,6 +107,51 @@ namespace network
 		_snipping_targets = snipping_targets;
 	}
 
+	void messaging_client::set_auto_reconnect(const bool& auto_reconnect, const unsigned int& min_delay_milliseconds, const unsigned int& max_delay_milliseconds)
+	{
+		_auto_reconnect = auto_reconnect;
+		_min_reconnect_delay = (std::max)(min_delay_milliseconds, 1u);
+		_max_reconnect_delay = (std::max)(max_delay_milliseconds, _min_reconnect_delay);
+	}
+
+	void messaging_client::set_connect_timeout(const unsigned short& connect_timeout_seconds)
+	{
+		_connect_timeout_seconds = connect_timeout_seconds;
+	}
+
+	void messaging_client::set_buffer_limit(const size_t& buffer_limit)
+	{
+		_buffer_limit = buffer_limit;
+	}
+
+	void messaging_client::set_batch_mode(const bool& batch_mode, const unsigned short& window_milliseconds, const size_t& window_bytes)
+	{
+		_batch_mode = batch_mode;
+		_batch_window_milliseconds = window_milliseconds;
+		_batch_window_bytes = window_bytes;
+	}
+
+	void messaging_client::set_stream_compression(const bool& stream_compression)
+	{
+		_stream_compression = stream_compression;
+	}
+
+	void messaging_client::set_compression_dictionary(const std::vector<unsigned char>& dictionary)
+	{
+		_compression_dictionary = dictionary;
+	}
+
+	void messaging_client::set_compression_threshold(const size_t& minimum_bytes)
+	{
+		_adaptive_compressor.set_minimum_bytes(minimum_bytes);
+	}
+
+	void messaging_client::set_codec(const compressing::codec_types& codec, const int& level)
+	{
+		_codec = codec;
+		_codec_level = level;
+	}
+
 	void messaging_client::set_connection_notification(const std::function<void(const std::wstring&, const std::wstring&, const bool&)>& notification)
 	{
 		_connection = notification;
@@ -119,10 +177,30 @@ namespace network
 		return _confirm;
 	}
 
+	size_t messaging_client::buffered_count(void)
+	{
+		std::scoped_lock<std::mutex> guard(_buffer_mutex);
+
+		return _buffered_messages.size();
+	}
+
+	long long messaging_client::last_reconnect_latency(void) const
+	{
+		return _last_reconnect_latency;
+	}
+
 	void messaging_client::start(const std::wstring& ip, const unsigned short& port, const unsigned short& high_priority, const unsigned short& normal_priority, const unsigned short& low_priority)
 	{
 		stop();
 
+		_ip = ip;
+		_port = port;
+		_high_priority = high_priority;
+		_normal_priority = normal_priority;
+		_low_priority = low_priority;
+		_reconnect_attempts = 0;
+		_reconnecting = false;
+
 		_thread_pool = std::make_shared<threads::thread_pool>();
 
 		_thread_pool->append(std::make_shared<thread_worker>(priorities::top), true);
@@ -142,41 +220,10 @@ namespace network
 		logger::handle().write(logging::logging_level::sequence, L"attempts to create io_context");
 
 		_io_context = std::make_shared<asio::io_context>();
-
-		logger::handle().write(logging::logging_level::sequence, L"attempts to create socket");
-
-		try
-		{
-			_socket = std::make_shared<asio::ip::tcp::socket>(*_io_context);
-			_socket->open(asio::ip::tcp::v4());
-			_socket->bind(asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
-			_socket->connect(asio::ip::tcp::endpoint(asio::ip::address::from_string(converter::to_string(ip)), port));
-
-			_socket->set_option(asio::ip::tcp::no_delay(true));
-			_socket->set_option(asio::socket_base::keep_alive(true));
-			_socket->set_option(asio::socket_base::receive_buffer_size(buffer_size));
-		}
-		catch (const std::overflow_error&) {
-			connection_notification(false);
-			return; 
-		}
-		catch (const std::runtime_error&) {
-			connection_notification(false);
-			return;
-		}
-		catch (const std::exception&) {
-			connection_notification(false);
-			return;
-		}
-		catch (...) {
-			connection_notification(false);
-			return;
-		}
-
-		_source_sub_id = fmt::format(L"{}:{}",
-			converter::to_wstring(_socket->local_endpoint().address().to_string()), _socket->local_endpoint().port());
-		_target_sub_id = fmt::format(L"{}:{}",
-			converter::to_wstring(_socket->remote_endpoint().address().to_string()), _socket->remote_endpoint().port());
+		_work_guard = std::make_shared<asio::executor_work_guard<asio::io_context::executor_type>>(asio::make_work_guard(*_io_context));
+		_connect_timer = std::make_shared<asio::steady_timer>(*_io_context);
+		_reconnect_timer = std::make_shared<asio::steady_timer>(*_io_context);
+		_running = true;
 
 		_thread = std::thread([this](std::shared_ptr<asio::io_context> context)
 			{
@@ -186,22 +233,22 @@ namespace network
 					context->run();
 				}
 				catch (const std::overflow_error&) { 
-					if (_socket != nullptr) {
+					if (std::atomic_load(&_socket) != nullptr) {
 						logger::handle().write(logging::logging_level::exception, fmt::format(L"break messaging_client({}) with overflow error", _source_id));
 					}
 				}
 				catch (const std::runtime_error&) { 
-					if (_socket != nullptr) {
+					if (std::atomic_load(&_socket) != nullptr) {
 						logger::handle().write(logging::logging_level::exception, fmt::format(L"break messaging_client({}) with runtime error", _source_id));
 					}
 				}
 				catch (const std::exception&) { 
-					if (_socket != nullptr) {
+					if (std::atomic_load(&_socket) != nullptr) {
 						logger::handle().write(logging::logging_level::exception, fmt::format(L"break messaging_client({}) with exception", _source_id));
 					}
 				}
 				catch (...) { 
-					if (_socket != nullptr) {
+					if (std::atomic_load(&_socket) != nullptr) {
 						logger::handle().write(logging::logging_level::exception, fmt::format(L"break messaging_client({}) with error", _source_id));
 					}
 				}
@@ -209,19 +256,27 @@ namespace network
 				connection_notification(false);
 			}, _io_context);
 
-		read_start_code(_socket);
-		send_connection();
+		asio::post(*_io_context, [this](void) { connect(); });
 	}
 
 	void messaging_client::stop(void)
 	{
-		if (_socket != nullptr)
+		_running = false;
+		_reconnecting = false;
+
+		std::shared_ptr<asio::ip::tcp::socket> socket = std::atomic_exchange(&_socket, std::shared_ptr<asio::ip::tcp::socket>(nullptr));
+		if (socket != nullptr)
 		{
-			if (_socket->is_open())
+			if (socket->is_open())
 			{
-				_socket->close();
+				socket->close();
 			}
-			_socket.reset();
+		}
+
+		if (_work_guard != nullptr)
+		{
+			_work_guard->reset();
+			_work_guard.reset();
 		}
 
 		if (_io_context != nullptr)
@@ -230,11 +285,19 @@ namespace network
 			_io_context.reset();
 		}
 
-		if (_thread.joinable())
+		if (_thread.joinable() && _thread.get_id() != std::this_thread::get_id())
 		{
 			_thread.join();
 		}
 
+		_connect_timer.reset();
+		_reconnect_timer.reset();
+
+		std::unique_lock<std::mutex> unique(_batch_mutex);
+		_batch_buffer.clear();
+		_batch_scheduled = false;
+		unique.unlock();
+
 		if (_thread_pool != nullptr)
 		{
 			_thread_pool->stop();
@@ -242,6 +305,257 @@ namespace network
 		}
 	}
 
+	void messaging_client::connect(void)
+	{
+		if (!_running || _io_context == nullptr)
+		{
+			return;
+		}
+
+		logger::handle().write(logging::logging_level::sequence, L"attempts to create socket");
+
+		std::shared_ptr<asio::ip::tcp::socket> socket = std::make_shared<asio::ip::tcp::socket>(*_io_context);
+		asio::ip::tcp::endpoint endpoint;
+
+		try
+		{
+			socket->open(asio::ip::tcp::v4());
+			socket->bind(asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+			endpoint = asio::ip::tcp::endpoint(asio::ip::address::from_string(converter::to_string(_ip)), _port);
+		}
+		catch (...) {
+			logger::handle().write(logging::logging_level::error, fmt::format(L"cannot prepare socket for {}:{}", _ip, _port));
+
+			if (!_auto_reconnect)
+			{
+				disconnected();
+				return;
+			}
+
+			_reconnecting = true;
+			schedule_reconnect();
+			return;
+		}
+
+		std::shared_ptr<asio::steady_timer> connect_timer = _connect_timer;
+		if (connect_timer != nullptr && _connect_timeout_seconds > 0)
+		{
+			connect_timer->expires_after(std::chrono::seconds(_connect_timeout_seconds));
+			connect_timer->async_wait([this, socket](const std::error_code& ec)
+				{
+					if (ec)
+					{
+						return;
+					}
+
+					logger::handle().write(logging::logging_level::error, fmt::format(L"connect timeout to {}:{}", _ip, _port));
+
+					if (socket->is_open())
+					{
+						socket->close();
+					}
+				});
+		}
+
+		socket->async_connect(endpoint, [this, socket, connect_timer](const std::error_code& ec)
+			{
+				if (connect_timer != nullptr)
+				{
+					connect_timer->cancel();
+				}
+
+				if (!_running)
+				{
+					return;
+				}
+
+				if (!ec && socket->is_open())
+				{
+					std::atomic_store(&_socket, socket);
+					connected();
+					return;
+				}
+
+				logger::handle().write(logging::logging_level::error, fmt::format(L"cannot connect to {}:{}", _ip, _port));
+
+				if (socket->is_open())
+				{
+					socket->close();
+				}
+
+				if (!_auto_reconnect)
+				{
+					disconnected();
+					return;
+				}
+
+				_reconnecting = true;
+				schedule_reconnect();
+			});
+	}
+
+	void messaging_client::connected(void)
+	{
+		// pool threads read the socket while sending, so it is only ever replaced atomically
+		std::shared_ptr<asio::ip::tcp::socket> socket = std::atomic_load(&_socket);
+
+		try
+		{
+			socket->set_option(asio::ip::tcp::no_delay(true));
+			socket->set_option(asio::socket_base::keep_alive(true));
+			socket->set_option(asio::socket_base::receive_buffer_size(buffer_size));
+
+			_source_sub_id = fmt::format(L"{}:{}",
+				converter::to_wstring(socket->local_endpoint().address().to_string()), socket->local_endpoint().port());
+			_target_sub_id = fmt::format(L"{}:{}",
+				converter::to_wstring(socket->remote_endpoint().address().to_string()), socket->remote_endpoint().port());
+
+			_utf8_source_sub_id = converter::to_string(_source_sub_id);
+		}
+		catch (...) {
+			socket->close();
+			disconnected();
+			return;
+		}
+
+		if (_reconnecting)
+		{
+			_last_reconnect_latency = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _disconnected_time).count();
+
+			logger::handle().write(logging::logging_level::information,
+				fmt::format(L"reconnected messaging_client({}) after {} attempts: {} ms, {} buffered messages", _source_id, _reconnect_attempts, _last_reconnect_latency, buffered_count()));
+		}
+
+		_reconnect_attempts = 0;
+		_reconnecting = false;
+
+		read_start_code(socket);
+		send_connection();
+	}
+
+	void messaging_client::schedule_reconnect(void)
+	{
+		std::shared_ptr<asio::steady_timer> reconnect_timer = _reconnect_timer;
+		if (!_running || reconnect_timer == nullptr)
+		{
+			return;
+		}
+
+		unsigned long long delay = _max_reconnect_delay;
+		if (_reconnect_attempts < 32)
+		{
+			delay = (std::min)((unsigned long long)_min_reconnect_delay << _reconnect_attempts, (unsigned long long)_max_reconnect_delay);
+		}
+
+		std::random_device device;
+		std::mt19937_64 engine(device());
+		std::uniform_int_distribution<unsigned long long> jitter(delay / 2, delay);
+		delay = jitter(engine);
+
+		if (_reconnect_attempts < (std::numeric_limits<unsigned short>::max)())
+		{
+			++_reconnect_attempts;
+		}
+
+		logger::handle().write(logging::logging_level::sequence,
+			fmt::format(L"messaging_client({}) will reconnect to {}:{} in {} ms (attempt {})", _source_id, _ip, _port, delay, _reconnect_attempts));
+
+		reconnect_timer->expires_after(std::chrono::milliseconds(delay));
+		reconnect_timer->async_wait([this](const std::error_code& ec)
+			{
+				if (ec)
+				{
+					return;
+				}
+
+				connect();
+			});
+	}
+
+	void messaging_client::flush_buffer(void)
+	{
+		// the caller holds _buffer_mutex, so no new send can overtake the buffered messages
+		std::deque<std::shared_ptr<container::value_container>> buffered_messages;
+		buffered_messages.swap(_buffered_messages);
+
+		if (buffered_messages.empty())
+		{
+			return;
+		}
+
+		logger::handle().write(logging::logging_level::information, fmt::format(L"flush {} buffered messages on messaging_client({})", buffered_messages.size(), _source_id));
+
+		for (auto& message : buffered_messages)
+		{
+			push_message(message);
+		}
+	}
+
+	void messaging_client::append_batch(std::shared_ptr<container::value_container> message)
+	{
+		std::unique_lock<std::mutex> unique(_batch_mutex);
+		append_binary_on_packet(_batch_buffer, message->serialize_array());
+		if (_batch_buffer.size() < _batch_window_bytes && _batch_scheduled)
+		{
+			return;
+		}
+
+		std::shared_ptr<asio::io_context> io_context = _io_context;
+		if (_batch_buffer.size() >= _batch_window_bytes || _batch_window_milliseconds == 0 || io_context == nullptr)
+		{
+			unique.unlock();
+
+			flush_batch();
+
+			return;
+		}
+
+		_batch_scheduled = true;
+		unique.unlock();
+
+		std::shared_ptr<asio::steady_timer> timer = std::make_shared<asio::steady_timer>(*io_context, std::chrono::milliseconds(_batch_window_milliseconds));
+		timer->async_wait([this, timer](const std::error_code& ec)
+			{
+				if (ec)
+				{
+					return;
+				}
+
+				flush_batch();
+			});
+	}
+
+	void messaging_client::flush_batch(void)
+	{
+		std::vector<unsigned char> batch;
+
+		std::unique_lock<std::mutex> unique(_batch_mutex);
+		batch.swap(_batch_buffer);
+		_batch_scheduled = false;
+		unique.unlock();
+
+		if (batch.empty() || _thread_pool == nullptr)
+		{
+			return;
+		}
+
+		if (_compress_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::high, batch, std::bind(&messaging_client::compress_batch_packet, this, std::placeholders::_1)));
+
+			return;
+		}
+
+		if (_encrypt_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::normal, batch, std::bind(&messaging_client::encrypt_batch_packet, this, std::placeholders::_1)));
+
+			return;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::top, batch, std::bind(&messaging_client::send_batch_packet, this, std::placeholders::_1)));
+	}
+
 	void messaging_client::echo(void)
 	{
 		std::shared_ptr<container::value_container> container = std::make_shared<container::value_container>(_source_id, _source_sub_id, _target_id, _target_sub_id, L"echo",
@@ -257,12 +571,39 @@ namespace network
 
 	void messaging_client::send(std::shared_ptr<container::value_container> message)
 	{
-		if (_socket == nullptr)
+		if (message == nullptr)
 		{
 			return;
 		}
 
-		if (message == nullptr)
+		if (_auto_reconnect && _running && message->message_type() != L"request_connection")
+		{
+			std::unique_lock<std::mutex> unique(_buffer_mutex);
+			if (!_confirm)
+			{
+				if (_buffer_limit == 0)
+				{
+					return;
+				}
+
+				if (_buffered_messages.size() >= _buffer_limit)
+				{
+					_buffered_messages.pop_front();
+					logger::handle().write(logging::logging_level::error, fmt::format(L"dropped oldest buffered message on messaging_client({}): limit {}", _source_id, _buffer_limit));
+				}
+
+				_buffered_messages.push_back(message);
+
+				return;
+			}
+		}
+
+		push_message(message);
+	}
+
+	void messaging_client::push_message(std::shared_ptr<container::value_container> message)
+	{
+		if (std::atomic_load(&_socket) == nullptr)
 		{
 			return;
 		}
@@ -277,6 +618,20 @@ namespace network
 			message->set_source(_source_id, _source_sub_id);
 		}
 
+		if (_batch_mode && message->message_type() != L"request_connection")
+		{
+			append_batch(message);
+
+			return;
+		}
+
+		if (_compress_mode && !_encrypt_mode && std::atomic_load(&_stream_compressor) != nullptr)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::top, message->serialize_array(), std::bind(&messaging_client::send_stream_packet, this, std::placeholders::_1)));
+
+			return;
+		}
+
 		if (_compress_mode)
 		{
 			_thread_pool->push(std::make_shared<job>(priorities::high, message->serialize_array(), std::bind(&messaging_client::compress_packet, this, std::placeholders::_1)));
@@ -301,7 +656,7 @@ namespace network
 
 	void messaging_client::send_files(std::shared_ptr<container::value_container> message)
 	{
-		if (_socket == nullptr)
+		if (std::atomic_load(&_socket) == nullptr)
 		{
 			return;
 		}
@@ -325,10 +680,11 @@ namespace network
 		container->swap_header();
 		container->set_message_type(L"request_file");
 
+		std::wstring indication_id = message->get_value(L"indication_id")->to_string();
 		std::vector<std::shared_ptr<container::value>> files = message->value_array(L"file");
 		for (auto& file : files)
 		{
-			container << std::make_shared<container::string_value>(L"indication_id", message->get_value(L"indication_id")->to_string());
+			container << std::make_shared<container::string_value>(L"indication_id", indication_id);
 			container << std::make_shared<container::string_value>(L"source", (*file)[L"source"]->to_string());
 			container << std::make_shared<container::string_value>(L"target", (*file)[L"target"]->to_string());
 
@@ -339,7 +695,12 @@ namespace network
 
 	void messaging_client::send_binary(const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data)
 	{
-		if (_socket == nullptr)
+		send_binary(converter::to_string(target_id), converter::to_string(target_sub_id), data);
+	}
+
+	void messaging_client::send_binary(const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data)
+	{
+		if (std::atomic_load(&_socket) == nullptr)
 		{
 			return;
 		}
@@ -350,8 +711,8 @@ namespace network
 		}
 
 		std::vector<unsigned char> result;
-		append_binary_on_packet(result, converter::to_array(_source_id));
-		append_binary_on_packet(result, converter::to_array(_source_sub_id));
+		append_binary_on_packet(result, converter::to_array(_utf8_source_id));
+		append_binary_on_packet(result, converter::to_array(_utf8_source_sub_id));
 		append_binary_on_packet(result, converter::to_array(target_id));
 		append_binary_on_packet(result, converter::to_array(target_sub_id));
 		append_binary_on_packet(result, data);
@@ -375,23 +736,29 @@ namespace network
 
 	void messaging_client::send_connection(void)
 	{
-		std::shared_ptr<container::container_value> snipping_targets = std::make_shared<container::container_value>(L"snipping_targets");
-		for (auto& snipping_target : _snipping_targets)
-		{
-			snipping_targets->add(std::make_shared<container::string_value>(L"snipping_target", snipping_target));
-		}
-
-		std::shared_ptr<container::value_container> container = std::make_shared<container::value_container>(_source_id, _source_sub_id, _target_id, _target_sub_id, L"request_connection",
-			std::vector<std::shared_ptr<container::value>> {
-				std::make_shared<container::string_value>(L"connection_key", _connection_key),
-				std::make_shared<container::bool_value>(L"auto_echo", _auto_echo),
-				std::make_shared<container::ushort_value>(L"auto_echo_interval_seconds", _auto_echo_interval_seconds),
-				std::make_shared<container::short_value>(L"session_type", (short)_session_type),
-				std::make_shared<container::bool_value>(L"bridge_mode", _bridge_line),
-				snipping_targets
-		});
-
-		send(container);
+		request_connection message;
+		message.connection_key = _connection_key;
+		message.auto_echo = _auto_echo;
+		message.auto_echo_interval_seconds = _auto_echo_interval_seconds;
+		message.session_type = (short)_session_type;
+		message.bridge_mode = _bridge_line;
+		message.snipping_targets = _snipping_targets;
+		message.stream_compression = _compress_mode && _stream_compression;
+		message.dictionary_id = compressor::dictionary_id(_compression_dictionary);
+		message.codec = (unsigned short)_codec;
+		message.codec_level = _codec_level;
+		message.codecs = codec_registry::registered_codecs();
+
+		// plain lz4 is used until the server confirms a codec, since it may not know the one asked for
+		// and may not even read stored payloads
+		_adaptive_compressor.set_codec(codec_types::lz4);
+		_adaptive_compressor.set_peer_codecs(0);
+
+		// the decoder is ready before the request leaves, since stream frames may arrive ahead of the confirm being handled
+		std::atomic_store(&_stream_compressor, std::shared_ptr<stream_compressor>(nullptr));
+		std::atomic_store(&_stream_decompressor, std::make_shared<stream_decompressor>(_compression_dictionary));
+
+		send(container::message_schema<request_connection>::to_container(message, _source_id, _source_sub_id, _target_id, _target_sub_id));
 	}
 
 	void messaging_client::receive_on_tcp(const data_modes& data_mode, const std::vector<unsigned char>& data)
@@ -404,14 +771,58 @@ namespace network
 		case data_modes::file_mode:
 			_thread_pool->push(std::make_shared<job>(priorities::high, data, std::bind(&messaging_client::decrypt_file_packet, this, std::placeholders::_1)));
 			break;
+		case data_modes::batch_mode:
+			_thread_pool->push(std::make_shared<job>(priorities::high, data, std::bind(&messaging_client::decrypt_batch_packet, this, std::placeholders::_1)));
+			break;
+		case data_modes::stream_mode:
+			// every stream frame depends on the ones before it, so it is decoded here in arrival order
+			decompress_stream_packet(data);
+			break;
 		}
 	}
 
 	void messaging_client::disconnected(void)
 	{
-		stop();
+		if (!_running)
+		{
+			return;
+		}
+
+		if (!_auto_reconnect)
+		{
+			stop();
+
+			connection_notification(false);
+
+			return;
+		}
+
+		if (_reconnecting.exchange(true))
+		{
+			return;
+		}
+
+		std::unique_lock<std::mutex> unique(_buffer_mutex);
+		_confirm = false;
+		unique.unlock();
+
+		_disconnected_time = std::chrono::steady_clock::now();
+
+		std::shared_ptr<asio::ip::tcp::socket> socket = std::atomic_exchange(&_socket, std::shared_ptr<asio::ip::tcp::socket>(nullptr));
+		if (socket != nullptr)
+		{
+			if (socket->is_open())
+			{
+				socket->close();
+			}
+		}
 
 		connection_notification(false);
+
+		if (_io_context != nullptr)
+		{
+			asio::post(*_io_context, [this](void) { schedule_reconnect(); });
+		}
 	}
 
 	bool messaging_client::compress_packet(const std::vector<unsigned char>& data)
@@ -423,12 +834,12 @@ namespace network
 
 		if (_encrypt_mode)
 		{
-			_thread_pool->push(std::make_shared<job>(priorities::normal, compressor::compression(data), std::bind(&messaging_client::encrypt_packet, this, std::placeholders::_1)));
+			_thread_pool->push(std::make_shared<job>(priorities::normal, _adaptive_compressor.compression(data, (unsigned char)data_modes::packet_mode), std::bind(&messaging_client::encrypt_packet, this, std::placeholders::_1)));
 
 			return true;
 		}
 
-		_thread_pool->push(std::make_shared<job>(priorities::top, compressor::compression(data), std::bind(&messaging_client::send_packet, this, std::placeholders::_1)));
+		_thread_pool->push(std::make_shared<job>(priorities::top, _adaptive_compressor.compression(data, (unsigned char)data_modes::packet_mode), std::bind(&messaging_client::send_packet, this, std::placeholders::_1)));
 
 		return true;
 	}
@@ -452,7 +863,7 @@ namespace network
 			return false;
 		}
 
-		return send_on_tcp(_socket, data_modes::packet_mode, data);
+		return send_on_tcp(std::atomic_load(&_socket), data_modes::packet_mode, data);
 	}
 
 	bool messaging_client::decompress_packet(const std::vector<unsigned char>& data)
@@ -508,6 +919,8 @@ namespace network
 			return false;
 		}
 
+		message->set_arena_mode(true);
+
 		auto target = _message_handlers.find(message->message_type());
 		if (target == _message_handlers.end())
 		{
@@ -568,12 +981,12 @@ namespace network
 
 		if (_encrypt_mode)
 		{
-			_thread_pool->push(std::make_shared<job>(priorities::normal, compressor::compression(data), std::bind(&messaging_client::encrypt_file_packet, this, std::placeholders::_1)));
+			_thread_pool->push(std::make_shared<job>(priorities::normal, _adaptive_compressor.compression(data, (unsigned char)data_modes::file_mode), std::bind(&messaging_client::encrypt_file_packet, this, std::placeholders::_1)));
 
 			return true;
 		}
 
-		_thread_pool->push(std::make_shared<job>(priorities::top, compressor::compression(data), std::bind(&messaging_client::send_file_packet, this, std::placeholders::_1)));
+		_thread_pool->push(std::make_shared<job>(priorities::top, _adaptive_compressor.compression(data, (unsigned char)data_modes::file_mode), std::bind(&messaging_client::send_file_packet, this, std::placeholders::_1)));
 
 		return true;
 	}
@@ -597,7 +1010,7 @@ namespace network
 			return false;
 		}
 
-		return send_on_tcp(_socket, data_modes::file_mode, data);
+		return send_on_tcp(std::atomic_load(&_socket), data_modes::file_mode, data);
 	}
 
 	bool messaging_client::decompress_file_packet(const std::vector<unsigned char>& data)
@@ -701,12 +1114,12 @@ namespace network
 
 		if (_encrypt_mode)
 		{
-			_thread_pool->push(std::make_shared<job>(priorities::normal, compressor::compression(data), std::bind(&messaging_client::encrypt_binary_packet, this, std::placeholders::_1)));
+			_thread_pool->push(std::make_shared<job>(priorities::normal, _adaptive_compressor.compression(data, (unsigned char)data_modes::binary_mode), std::bind(&messaging_client::encrypt_binary_packet, this, std::placeholders::_1)));
 
 			return true;
 		}
 
-		_thread_pool->push(std::make_shared<job>(priorities::top, compressor::compression(data), std::bind(&messaging_client::send_binary_packet, this, std::placeholders::_1)));
+		_thread_pool->push(std::make_shared<job>(priorities::top, _adaptive_compressor.compression(data, (unsigned char)data_modes::binary_mode), std::bind(&messaging_client::send_binary_packet, this, std::placeholders::_1)));
 
 		return true;
 	}
@@ -730,7 +1143,7 @@ namespace network
 			return false;
 		}
 
-		return send_on_tcp(_socket, data_modes::binary_mode, data);
+		return send_on_tcp(std::atomic_load(&_socket), data_modes::binary_mode, data);
 	}
 
 	bool messaging_client::decompress_binary_packet(const std::vector<unsigned char>& data)
@@ -792,6 +1205,147 @@ namespace network
 		return true;
 	}
 
+	bool messaging_client::compress_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		if (_encrypt_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::normal, _adaptive_compressor.compression(data, (unsigned char)data_modes::batch_mode), std::bind(&messaging_client::encrypt_batch_packet, this, std::placeholders::_1)));
+
+			return true;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::top, _adaptive_compressor.compression(data, (unsigned char)data_modes::batch_mode), std::bind(&messaging_client::send_batch_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
+	bool messaging_client::encrypt_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::top, encryptor::encryption(data, _key, _iv), std::bind(&messaging_client::send_batch_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
+	bool messaging_client::send_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		return send_on_tcp(std::atomic_load(&_socket), data_modes::batch_mode, data);
+	}
+
+	bool messaging_client::decompress_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		if (_compress_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::normal, compressor::decompression(data), std::bind(&messaging_client::receive_batch_packet, this, std::placeholders::_1)));
+
+			return true;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::high, data, std::bind(&messaging_client::receive_batch_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
+	bool messaging_client::decrypt_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		if (_encrypt_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::high, encryptor::decryption(data, _key, _iv), std::bind(&messaging_client::decompress_batch_packet, this, std::placeholders::_1)));
+
+			return true;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::high, data, std::bind(&messaging_client::decompress_batch_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
+	bool messaging_client::receive_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		// messages are handed over one by one in this job, so their order within the batch is kept
+		size_t index = 0;
+		std::vector<unsigned char> packet = devide_binary_on_packet(data, index);
+		while (!packet.empty())
+		{
+			receive_packet(packet);
+			packet = devide_binary_on_packet(data, index);
+		}
+
+		return true;
+	}
+
+	bool messaging_client::send_stream_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		// compressed in the send job itself: the single top worker keeps the stream in wire order
+		std::shared_ptr<stream_compressor> stream = std::atomic_load(&_stream_compressor);
+		if (stream == nullptr)
+		{
+			return false;
+		}
+
+		return send_on_tcp(std::atomic_load(&_socket), data_modes::stream_mode, stream->compression(data));
+	}
+
+	bool messaging_client::decompress_stream_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		std::shared_ptr<stream_decompressor> stream = std::atomic_load(&_stream_decompressor);
+		if (stream == nullptr)
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot decompress stream packet without stream context");
+
+			return false;
+		}
+
+		std::vector<unsigned char> decompressed_data = stream->decompression(data);
+		if (decompressed_data.empty())
+		{
+			return false;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::high, decompressed_data, std::bind(&messaging_client::receive_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
 	bool messaging_client::normal_message(std::shared_ptr<container::value_container> message)
 	{
 		if (message == nullptr)
@@ -828,11 +1382,34 @@ namespace network
 			return false;
 		}
 
-		_confirm = true;
 		_key = message->get_value(L"key")->to_string();
 		_iv = message->get_value(L"iv")->to_string();
 		_encrypt_mode = message->get_value(L"encrypt_mode")->to_boolean();
 
+		if (_compress_mode && message->get_value(L"stream_compression")->to_boolean())
+		{
+			bool same_dictionary = message->get_value(L"dictionary_id")->to_uint() == compressor::dictionary_id(_compression_dictionary);
+			std::atomic_store(&_stream_compressor, std::make_shared<stream_compressor>(same_dictionary ? _compression_dictionary : std::vector<unsigned char>()));
+		}
+
+		std::shared_ptr<value> codec = message->find_value(L"codec");
+		if (codec != nullptr)
+		{
+			_adaptive_compressor.set_codec((codec_types)codec->to_ushort(), message->get_value(L"codec_level")->to_int());
+		}
+
+		std::shared_ptr<value> codecs = message->find_value(L"codecs");
+		if (codecs != nullptr)
+		{
+			_adaptive_compressor.set_peer_codecs(codecs->to_uint());
+		}
+
+		// a send waiting on the lock sees the line confirmed only after every buffered message has been queued
+		std::unique_lock<std::mutex> unique(_buffer_mutex);
+		flush_buffer();
+		_confirm = true;
+		unique.unlock();
+
 		std::vector<std::shared_ptr<value>> snipping_targets = message->get_value(L"snipping_targets")->children();
 		for (auto& snipping_target : snipping_targets)
 		{
@@ -878,7 +1455,7 @@ namespace network
 
 		message << std::make_shared<bool_value>(L"response", true);
 
-		_thread_pool->push(std::make_shared<job>(priorities::top, message->serialize_array(), std::bind(&messaging_client::send_packet, this, std::placeholders::_1)));
+		send(message);
 
 		return true;
 	}
@@ -890,14 +1467,19 @@ namespace network
 			_confirm = false;
 		}
 
-		// Need to find out more efficient way
-		std::thread thread([this](const bool& connection) 
+		if (!_connection)
+		{
+			return;
+		}
+
+		std::wstring target_id = _target_id;
+		std::wstring target_sub_id = _target_sub_id;
+		_event_dispatcher->push([this, target_id, target_sub_id, condition](void)
 			{
 				if (_connection)
 				{
-					_connection(_target_id, _target_sub_id, connection);
+					_connection(target_id, target_sub_id, condition);
 				}
-			}, condition);
-		thread.detach();
+			});
 	}
 }
\ No newline at end of file
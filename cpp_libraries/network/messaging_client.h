@@ -3,9 +3,17 @@
 #include "container.h"
 #include "thread_pool.h"
 #include "data_handling.h"
+#include "adaptive_compressor.h"
+#include "stream_compressor.h"
+#include "stream_decompressor.h"
 #include "session_types.h"
+#include "event_dispatcher.h"
 
 #include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <functional>
@@ -35,6 +43,14 @@ namespace network
 		void set_session_types(const session_types& session_type);
 		void set_connection_key(const std::wstring& connection_key);
 		void set_snipping_targets(const std::vector<std::wstring>& snipping_targets);
+		void set_auto_reconnect(const bool& auto_reconnect, const unsigned int& min_delay_milliseconds = 500, const unsigned int& max_delay_milliseconds = 30000);
+		void set_connect_timeout(const unsigned short& connect_timeout_seconds);
+		void set_buffer_limit(const size_t& buffer_limit);
+		void set_batch_mode(const bool& batch_mode, const unsigned short& window_milliseconds = 5, const size_t& window_bytes = 65536);
+		void set_stream_compression(const bool& stream_compression);
+		void set_compression_dictionary(const std::vector<unsigned char>& dictionary);
+		void set_compression_threshold(const size_t& minimum_bytes);
+		void set_codec(const compressing::codec_types& codec, const int& level = 0);
 
 	public:
 		void set_connection_notification(const std::function<void(const std::wstring&, const std::wstring&, const bool&)>& notification);
@@ -44,6 +60,8 @@ namespace network
 
 	public:
 		bool is_confirmed(void) const;
+		size_t buffered_count(void);
+		long long last_reconnect_latency(void) const;
 		void start(const std::wstring& ip, const unsigned short& port, const unsigned short& high_priority = 8, const unsigned short& normal_priority = 8, const unsigned short& low_priority = 8);
 		void stop(void);
 
@@ -54,6 +72,16 @@ namespace network
 		void send_files(const container::value_container& message);
 		void send_files(std::shared_ptr<container::value_container> message);
 		void send_binary(const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data);
+		void send_binary(const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data);
+
+	protected:
+		void connect(void);
+		void connected(void);
+		void schedule_reconnect(void);
+		void flush_buffer(void);
+		void push_message(std::shared_ptr<container::value_container> message);
+		void append_batch(std::shared_ptr<container::value_container> message);
+		void flush_batch(void);
 
 	protected:
 		void send_connection(void);
@@ -95,6 +123,22 @@ namespace network
 		bool decrypt_binary_packet(const std::vector<unsigned char>& data);
 		bool receive_binary_packet(const std::vector<unsigned char>& data);
 
+		// batch
+	private:
+		bool compress_batch_packet(const std::vector<unsigned char>& data);
+		bool encrypt_batch_packet(const std::vector<unsigned char>& data);
+		bool send_batch_packet(const std::vector<unsigned char>& data);
+
+	private:
+		bool decompress_batch_packet(const std::vector<unsigned char>& data);
+		bool decrypt_batch_packet(const std::vector<unsigned char>& data);
+		bool receive_batch_packet(const std::vector<unsigned char>& data);
+
+		// stream
+	private:
+		bool send_stream_packet(const std::vector<unsigned char>& data);
+		bool decompress_stream_packet(const std::vector<unsigned char>& data);
+
 	private:
 		bool normal_message(std::shared_ptr<container::value_container> message);
 		bool confirm_message(std::shared_ptr<container::value_container> message);
@@ -104,7 +148,7 @@ namespace network
 		void connection_notification(const bool& condition);
 
 	private:
-		bool _confirm;
+		std::atomic<bool> _confirm;
 		bool _auto_echo;
 		bool _bridge_line;
 		session_types _session_type;
@@ -113,12 +157,52 @@ namespace network
 		std::wstring _target_id;
 		std::wstring _target_sub_id;
 		std::wstring _connection_key;
+		std::string _utf8_source_id;
+		std::string _utf8_source_sub_id;
 		unsigned short _auto_echo_interval_seconds;
 		std::vector<std::wstring> _snipping_targets;
 
+	private:
+		std::wstring _ip;
+		unsigned short _port;
+		unsigned short _high_priority;
+		unsigned short _normal_priority;
+		unsigned short _low_priority;
+
+	private:
+		bool _auto_reconnect;
+		unsigned int _min_reconnect_delay;
+		unsigned int _max_reconnect_delay;
+		unsigned short _connect_timeout_seconds;
+		unsigned short _reconnect_attempts;
+		std::atomic<bool> _running{ false };
+		std::atomic<bool> _reconnecting{ false };
+		std::atomic<long long> _last_reconnect_latency{ 0 };
+		std::chrono::steady_clock::time_point _disconnected_time;
+
+	private:
+		size_t _buffer_limit;
+		std::mutex _buffer_mutex;
+		std::deque<std::shared_ptr<container::value_container>> _buffered_messages;
+
+	private:
+		bool _batch_mode;
+		bool _batch_scheduled;
+		unsigned short _batch_window_milliseconds;
+		size_t _batch_window_bytes;
+		std::mutex _batch_mutex;
+		std::vector<unsigned char> _batch_buffer;
+
 	private:
 		bool _compress_mode;
 		bool _encrypt_mode;
+		bool _stream_compression;
+		std::vector<unsigned char> _compression_dictionary;
+		compressing::codec_types _codec;
+		int _codec_level;
+		std::shared_ptr<compressing::stream_compressor> _stream_compressor;
+		std::shared_ptr<compressing::stream_decompressor> _stream_decompressor;
+		compressing::adaptive_compressor _adaptive_compressor;
 		std::wstring _key;
 		std::wstring _iv;
 
@@ -132,6 +216,10 @@ namespace network
 		std::thread _thread;
 		std::shared_ptr<asio::io_context> _io_context;
 		std::shared_ptr<asio::ip::tcp::socket> _socket;
+		std::shared_ptr<asio::steady_timer> _connect_timer;
+		std::shared_ptr<asio::steady_timer> _reconnect_timer;
+		std::shared_ptr<asio::executor_work_guard<asio::io_context::executor_type>> _work_guard;
+		std::shared_ptr<event_dispatcher> _event_dispatcher;
 
 	private:
 		std::shared_ptr<threads::thread_pool> _thread_pool;
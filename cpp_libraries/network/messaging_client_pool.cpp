@@ -0,0 +1,356 @@
+#include "messaging_client_pool.h"
+
+#include "logging.h"
+
+#include "fmt/format.h"
+
+namespace network
+{
+	using namespace logging;
+
+	messaging_client_pool::messaging_client_pool(const std::wstring& source_id, const unsigned short& message_line_count, const unsigned short& file_line_count)
+		: _source_id(source_id)
+	{
+		for (unsigned short index = 0; index < message_line_count; ++index)
+		{
+			std::shared_ptr<messaging_client> line = std::make_shared<messaging_client>(source_id);
+			line->set_session_types(session_types::message_line);
+			_message_lines.push_back(line);
+		}
+
+		for (unsigned short index = 0; index < file_line_count; ++index)
+		{
+			std::shared_ptr<messaging_client> line = std::make_shared<messaging_client>(source_id);
+			line->set_session_types(session_types::file_line);
+			_file_lines.push_back(line);
+		}
+	}
+
+	messaging_client_pool::~messaging_client_pool(void)
+	{
+		stop();
+	}
+
+	std::shared_ptr<messaging_client_pool> messaging_client_pool::get_ptr(void)
+	{
+		return shared_from_this();
+	}
+
+	std::wstring messaging_client_pool::source_id(void) const
+	{
+		return _source_id;
+	}
+
+	void messaging_client_pool::set_auto_echo(const bool& auto_echo, const unsigned short& echo_interval)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_auto_echo(auto_echo, echo_interval);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->set_auto_echo(auto_echo, echo_interval);
+		}
+	}
+
+	void messaging_client_pool::set_bridge_line(const bool& bridge_line)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_bridge_line(bridge_line);
+		}
+	}
+
+	void messaging_client_pool::set_compress_mode(const bool& compress_mode)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_compress_mode(compress_mode);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->set_compress_mode(compress_mode);
+		}
+	}
+
+	void messaging_client_pool::set_auto_reconnect(const bool& auto_reconnect, const unsigned int& min_delay_milliseconds, const unsigned int& max_delay_milliseconds)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_auto_reconnect(auto_reconnect, min_delay_milliseconds, max_delay_milliseconds);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->set_auto_reconnect(auto_reconnect, min_delay_milliseconds, max_delay_milliseconds);
+		}
+	}
+
+	void messaging_client_pool::set_connect_timeout(const unsigned short& connect_timeout_seconds)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_connect_timeout(connect_timeout_seconds);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->set_connect_timeout(connect_timeout_seconds);
+		}
+	}
+
+	void messaging_client_pool::set_batch_mode(const bool& batch_mode, const unsigned short& window_milliseconds, const size_t& window_bytes)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_batch_mode(batch_mode, window_milliseconds, window_bytes);
+		}
+	}
+
+	void messaging_client_pool::set_stream_compression(const bool& stream_compression)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_stream_compression(stream_compression);
+		}
+	}
+
+	void messaging_client_pool::set_compression_dictionary(const std::vector<unsigned char>& dictionary)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_compression_dictionary(dictionary);
+		}
+	}
+
+	void messaging_client_pool::set_compression_threshold(const size_t& minimum_bytes)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_compression_threshold(minimum_bytes);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->set_compression_threshold(minimum_bytes);
+		}
+	}
+
+	void messaging_client_pool::set_codec(const compressing::codec_types& codec, const int& level)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_codec(codec, level);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->set_codec(codec, level);
+		}
+	}
+
+	void messaging_client_pool::set_connection_key(const std::wstring& connection_key)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_connection_key(connection_key);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->set_connection_key(connection_key);
+		}
+	}
+
+	void messaging_client_pool::set_snipping_targets(const std::vector<std::wstring>& snipping_targets)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_snipping_targets(snipping_targets);
+		}
+	}
+
+	void messaging_client_pool::set_connection_notification(const std::function<void(const std::wstring&, const std::wstring&, const bool&)>& notification)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_connection_notification(notification);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->set_connection_notification(notification);
+		}
+	}
+
+	void messaging_client_pool::set_message_notification(const std::function<void(std::shared_ptr<container::value_container>)>& notification)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->set_message_notification(notification);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->set_message_notification(notification);
+		}
+	}
+
+	void messaging_client_pool::set_file_notification(const std::function<void(const std::wstring&, const std::wstring&, const std::wstring&, const std::wstring&)>& notification)
+	{
+		for (auto& line : _file_lines)
+		{
+			line->set_file_notification(notification);
+		}
+	}
+
+	bool messaging_client_pool::is_confirmed(void) const
+	{
+		return confirmed_count() > 0;
+	}
+
+	size_t messaging_client_pool::confirmed_count(void) const
+	{
+		size_t count = 0;
+
+		for (auto& line : _message_lines)
+		{
+			if (line->is_confirmed())
+			{
+				count++;
+			}
+		}
+
+		return count;
+	}
+
+	void messaging_client_pool::start(const std::wstring& ip, const unsigned short& port, const unsigned short& high_priority, const unsigned short& normal_priority, const unsigned short& low_priority)
+	{
+		logger::handle().write(logging::logging_level::information, fmt::format(L"start messaging_client_pool({}): {} message lines, {} file lines", 
+			_source_id, _message_lines.size(), _file_lines.size()));
+
+		for (auto& line : _message_lines)
+		{
+			line->start(ip, port, high_priority, normal_priority, low_priority);
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->start(ip, port, high_priority, normal_priority, low_priority);
+		}
+	}
+
+	void messaging_client_pool::stop(void)
+	{
+		for (auto& line : _message_lines)
+		{
+			line->stop();
+		}
+
+		for (auto& line : _file_lines)
+		{
+			line->stop();
+		}
+	}
+
+	void messaging_client_pool::send(std::shared_ptr<container::value_container> message, const std::wstring& stream_key)
+	{
+		if (message == nullptr || _message_lines.empty())
+		{
+			return;
+		}
+
+		if (!stream_key.empty())
+		{
+			// a keyed message never moves to another line, where it could overtake the ones sent before it
+			std::shared_ptr<messaging_client> line = _message_lines[std::hash<std::wstring>{}(stream_key) % _message_lines.size()];
+			if (line == nullptr || !line->is_confirmed())
+			{
+				logger::handle().write(logging::logging_level::error, fmt::format(L"cannot send message on messaging_client_pool({}): line for stream {} is not confirmed", _source_id, stream_key));
+
+				return;
+			}
+
+			line->send(message);
+
+			return;
+		}
+
+		std::shared_ptr<messaging_client> line = select_line(_message_lines, _message_line_index.fetch_add(1));
+		if (line == nullptr)
+		{
+			logger::handle().write(logging::logging_level::error, fmt::format(L"cannot send message on messaging_client_pool({}): no confirmed line", _source_id));
+
+			return;
+		}
+
+		line->send(message);
+	}
+
+	void messaging_client_pool::send_on_file_line(std::shared_ptr<container::value_container> message)
+	{
+		if (message == nullptr)
+		{
+			return;
+		}
+
+		std::shared_ptr<messaging_client> line = select_file_line();
+		if (line == nullptr)
+		{
+			return;
+		}
+
+		line->send(message);
+	}
+
+	void messaging_client_pool::send_files(std::shared_ptr<container::value_container> message)
+	{
+		if (message == nullptr)
+		{
+			return;
+		}
+
+		std::shared_ptr<messaging_client> line = select_file_line();
+		if (line == nullptr)
+		{
+			return;
+		}
+
+		// the file line reads and ships every listed file itself, so bulk frames stay off the message lines
+		line->send_files(message);
+	}
+
+	std::shared_ptr<messaging_client> messaging_client_pool::select_line(const std::vector<std::shared_ptr<messaging_client>>& lines, const size_t& index) const
+	{
+		for (size_t offset = 0; offset < lines.size(); ++offset)
+		{
+			std::shared_ptr<messaging_client> line = lines[(index + offset) % lines.size()];
+			if (line != nullptr && line->is_confirmed())
+			{
+				return line;
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::shared_ptr<messaging_client> messaging_client_pool::select_file_line(void)
+	{
+		if (_file_lines.empty())
+		{
+			logger::handle().write(logging::logging_level::error, fmt::format(L"cannot send files on messaging_client_pool({}): no file line", _source_id));
+
+			return nullptr;
+		}
+
+		std::shared_ptr<messaging_client> line = select_line(_file_lines, _file_line_index.fetch_add(1));
+		if (line == nullptr)
+		{
+			logger::handle().write(logging::logging_level::error, fmt::format(L"cannot send files on messaging_client_pool({}): no confirmed line", _source_id));
+		}
+
+		return line;
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "messaging_client.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+#include <functional>
+
+namespace network
+{
+	class messaging_client_pool : public std::enable_shared_from_this<messaging_client_pool>
+	{
+	public:
+		messaging_client_pool(const std::wstring& source_id, const unsigned short& message_line_count = 2, const unsigned short& file_line_count = 1);
+		~messaging_client_pool(void);
+
+	public:
+		std::shared_ptr<messaging_client_pool> get_ptr(void);
+
+	public:
+		std::wstring source_id(void) const;
+
+	public:
+		void set_auto_echo(const bool& auto_echo, const unsigned short& echo_interval);
+		void set_bridge_line(const bool& bridge_line);
+		void set_compress_mode(const bool& compress_mode);
+		void set_auto_reconnect(const bool& auto_reconnect, const unsigned int& min_delay_milliseconds = 500, const unsigned int& max_delay_milliseconds = 30000);
+		void set_connect_timeout(const unsigned short& connect_timeout_seconds);
+		void set_batch_mode(const bool& batch_mode, const unsigned short& window_milliseconds = 5, const size_t& window_bytes = 65536);
+		void set_stream_compression(const bool& stream_compression);
+		void set_compression_dictionary(const std::vector<unsigned char>& dictionary);
+		void set_compression_threshold(const size_t& minimum_bytes);
+		void set_codec(const compressing::codec_types& codec, const int& level = 0);
+		void set_connection_key(const std::wstring& connection_key);
+		void set_snipping_targets(const std::vector<std::wstring>& snipping_targets);
+
+	public:
+		void set_connection_notification(const std::function<void(const std::wstring&, const std::wstring&, const bool&)>& notification);
+		void set_message_notification(const std::function<void(std::shared_ptr<container::value_container>)>& notification);
+		void set_file_notification(const std::function<void(const std::wstring&, const std::wstring&, const std::wstring&, const std::wstring&)>& notification);
+
+	public:
+		bool is_confirmed(void) const;
+		size_t confirmed_count(void) const;
+		void start(const std::wstring& ip, const unsigned short& port, const unsigned short& high_priority = 2, const unsigned short& normal_priority = 2, const unsigned short& low_priority = 2);
+		void stop(void);
+
+	public:
+		// messages sharing a stream key always leave through the same connection and fail rather than move while it is down;
+		// they arrive in order when that line sends without compress and encrypt stages or uses stream compression,
+		// since those stages otherwise run on several workers
+		void send(std::shared_ptr<container::value_container> message, const std::wstring& stream_key = L"");
+		void send_on_file_line(std::shared_ptr<container::value_container> message);
+		void send_files(std::shared_ptr<container::value_container> message);
+
+	private:
+		std::shared_ptr<messaging_client> select_line(const std::vector<std::shared_ptr<messaging_client>>& lines, const size_t& index) const;
+		std::shared_ptr<messaging_client> select_file_line(void);
+
+	private:
+		std::wstring _source_id;
+		std::atomic<size_t> _message_line_index{ 0 };
+		std::atomic<size_t> _file_line_index{ 0 };
+
+	private:
+		std::vector<std::shared_ptr<messaging_client>> _message_lines;
+		std::vector<std::shared_ptr<messaging_client>> _file_lines;
+	};
+}
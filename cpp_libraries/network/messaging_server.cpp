@@ -3,8 +3,6 @@
 #include "logging.h"
 #include "converting.h"
 #include "messaging_session.h"
-#include "thread_worker.h"
-#include "job.h"
 
 #include "fmt/format.h"
 
@@ -13,20 +11,22 @@
 namespace network
 {
 	using namespace logging;
-	using namespace threads;
 	using namespace converting;
 
 	messaging_server::messaging_server(const std::wstring& source_id)
 		: _io_context(nullptr), _acceptor(nullptr), _source_id(source_id), _connection_key(L"connection_key"), _encrypt_mode(false),
 		_received_file(nullptr), _received_data(nullptr), _connection(nullptr), _received_message(nullptr), _compress_mode(false),
-		_high_priority(8), _normal_priority(8), _low_priority(8), _session_limit_count(0), _possible_session_types({ session_types::binary_line })
+		_batch_mode(false), _batch_window_milliseconds(5), _batch_window_bytes(65536), _stream_compression(false), _compression_threshold(256), _codec(compressing::codec_types::lz4), _codec_level(0),
+		_high_priority(8), _normal_priority(8), _low_priority(8), _session_limit_count(0), _idle_timeout_seconds(0), _echo_missing_limit(3), _timer_scheduler(nullptr), _event_dispatcher(std::make_shared<event_dispatcher>()), _possible_session_types({ session_types::binary_line })
 	{
-
+		_event_dispatcher->start();
 	}
 
 	messaging_server::~messaging_server(void)
 	{
 		stop();
+
+		_event_dispatcher->stop();
 	}
 
 	std::shared_ptr<messaging_server> messaging_server::get_ptr(void)
@@ -69,6 +69,44 @@ namespace network
 		_session_limit_count = session_limit_count;
 	}
 
+	void messaging_server::set_idle_timeout(const unsigned short& idle_timeout_seconds)
+	{
+		_idle_timeout_seconds = idle_timeout_seconds;
+	}
+
+	void messaging_server::set_echo_missing_limit(const unsigned short& echo_missing_limit)
+	{
+		_echo_missing_limit = echo_missing_limit;
+	}
+
+	void messaging_server::set_batch_mode(const bool& batch_mode, const unsigned short& window_milliseconds, const size_t& window_bytes)
+	{
+		_batch_mode = batch_mode;
+		_batch_window_milliseconds = window_milliseconds;
+		_batch_window_bytes = window_bytes;
+	}
+
+	void messaging_server::set_stream_compression(const bool& stream_compression)
+	{
+		_stream_compression = stream_compression;
+	}
+
+	void messaging_server::set_compression_dictionary(const std::vector<unsigned char>& dictionary)
+	{
+		_compression_dictionary = dictionary;
+	}
+
+	void messaging_server::set_compression_threshold(const size_t& minimum_bytes)
+	{
+		_compression_threshold = minimum_bytes;
+	}
+
+	void messaging_server::set_codec(const compressing::codec_types& codec, const int& level)
+	{
+		_codec = codec;
+		_codec_level = level;
+	}
+
 	void messaging_server::set_connection_notification(const std::function<void(const std::wstring&, const std::wstring&, const bool&)>& notification)
 	{
 		_connection = notification;
@@ -93,15 +131,13 @@ namespace network
 	{
 		stop();
 
-		_thread_pool = std::make_shared<threads::thread_pool>();
-		_thread_pool->append(std::make_shared<thread_worker>(priorities::high), true);
-
 		_high_priority = high_priority;
 		_normal_priority = normal_priority;
 		_low_priority = low_priority;
 
 		_io_context = std::make_shared<asio::io_context>();
 		_acceptor = std::make_shared<asio::ip::tcp::acceptor>(*_io_context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+		_timer_scheduler = std::make_shared<timer_scheduler>(_io_context);
 
 		wait_connection();
 
@@ -139,10 +175,9 @@ namespace network
 
 	void messaging_server::stop(void)
 	{
-		if (_thread_pool != nullptr)
+		if (_timer_scheduler != nullptr)
 		{
-			_thread_pool->stop();
-			_thread_pool.reset();
+			_timer_scheduler->stop_all();
 		}
 
 		if (_acceptor != nullptr)
@@ -154,7 +189,7 @@ namespace network
 			_acceptor.reset();
 		}
 
-		for (auto& session : _sessions)
+		for (auto& session : current_sessions())
 		{
 			if (session == nullptr)
 			{
@@ -163,7 +198,10 @@ namespace network
 
 			session->stop();
 		}
+
+		std::unique_lock<std::mutex> unique(_sessions_mutex);
 		_sessions.clear();
+		unique.unlock();
 
 		if (_io_context != nullptr)
 		{
@@ -177,11 +215,45 @@ namespace network
 		{
 			_thread.join();
 		}
+
+		_timer_scheduler.reset();
+	}
+
+	size_t messaging_server::active_timer_count(void)
+	{
+		if (_timer_scheduler == nullptr)
+		{
+			return 0;
+		}
+
+		return _timer_scheduler->active_count();
+	}
+
+	std::map<std::wstring, rtt_statistics> messaging_server::round_trip_statistics(void)
+	{
+		std::map<std::wstring, rtt_statistics> result;
+
+		for (auto& session : current_sessions())
+		{
+			if (session == nullptr)
+			{
+				continue;
+			}
+
+			if (session->get_confirom_status() != session_conditions::confirmed)
+			{
+				continue;
+			}
+
+			result.insert({ fmt::format(L"{}[{}]", session->target_id(), session->target_sub_id()), session->round_trip_statistics() });
+		}
+
+		return result;
 	}
 
 	void messaging_server::echo(void)
 	{
-		for (auto& session : _sessions)
+		for (auto& session : current_sessions())
 		{
 			if (session == nullptr)
 			{
@@ -204,7 +276,7 @@ namespace network
 			return;
 		}
 
-		for (auto& session : _sessions)
+		for (auto& session : current_sessions())
 		{
 			if (session == nullptr)
 			{
@@ -227,7 +299,7 @@ namespace network
 			return;
 		}
 
-		for (auto& session : _sessions)
+		for (auto& session : current_sessions())
 		{
 			if (session == nullptr)
 			{
@@ -239,13 +311,23 @@ namespace network
 	}
 
 	void messaging_server::send_binary(const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data)
+	{
+		send_binary(converter::to_string(target_id), converter::to_string(target_sub_id), data);
+	}
+
+	void messaging_server::send_binary(const std::wstring source_id, const std::wstring& source_sub_id, const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data)
+	{
+		send_binary(converter::to_string(source_id), converter::to_string(source_sub_id), converter::to_string(target_id), converter::to_string(target_sub_id), data);
+	}
+
+	void messaging_server::send_binary(const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data)
 	{
 		if (data.empty())
 		{
 			return;
 		}
 
-		for (auto& session : _sessions)
+		for (auto& session : current_sessions())
 		{
 			if (session == nullptr)
 			{
@@ -256,14 +338,14 @@ namespace network
 		}
 	}
 
-	void messaging_server::send_binary(const std::wstring source_id, const std::wstring& source_sub_id, const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data)
+	void messaging_server::send_binary(const std::string& source_id, const std::string& source_sub_id, const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data)
 	{
 		if (data.empty())
 		{
 			return;
 		}
 
-		for (auto& session : _sessions)
+		for (auto& session : current_sessions())
 		{
 			if (session == nullptr)
 			{
@@ -297,9 +379,17 @@ namespace network
 
 				if (_session_limit_count > 0)
 				{
-					session->set_kill_code(_sessions.size() >= _session_limit_count);
+					session->set_kill_code(current_sessions().size() >= _session_limit_count);
 				}
 
+				session->set_idle_timeout(_idle_timeout_seconds);
+				session->set_echo_missing_limit(_echo_missing_limit);
+				session->set_timer_scheduler(_timer_scheduler);
+				session->set_batch_mode(_batch_mode, _batch_window_milliseconds, _batch_window_bytes);
+				session->set_stream_compression(_stream_compression);
+				session->set_compression_dictionary(_compression_dictionary);
+				session->set_compression_threshold(_compression_threshold);
+				session->set_codec(_codec, _codec_level);
 				session->set_ignore_target_ids(_ignore_target_ids);
 				session->set_ignore_snipping_targets(_ignore_snipping_targets);
 				session->set_connection_notification(std::bind(&messaging_server::connect_condition, this, std::placeholders::_1, std::placeholders::_2));
@@ -309,33 +399,20 @@ namespace network
 
 				session->start(_encrypt_mode, _compress_mode, _possible_session_types, _high_priority, _normal_priority, _low_priority);
 
+				std::unique_lock<std::mutex> unique(_sessions_mutex);
 				_sessions.push_back(session);
-
-				_thread_pool->push(std::make_shared<job>(priorities::high, std::bind(&messaging_server::check_confirm_condition, this)));
+				unique.unlock();
 
 				wait_connection();
 			});
 	}
 
-	bool messaging_server::check_confirm_condition(void)
+	std::vector<std::shared_ptr<messaging_session>> messaging_server::current_sessions(void)
 	{
-		std::this_thread::sleep_for(std::chrono::seconds(1));
-
-		std::vector<std::shared_ptr<messaging_session>> sessions = _sessions;
-		for (auto& session : sessions)
-		{
-			if (session == nullptr)
-			{
-				continue;
-			}
-
-			if (session->get_confirom_status() == session_conditions::expired)
-			{
-				connect_condition(session, false);
-			}
-		}
+		// the io thread adds and removes sessions while callers iterate them from other threads
+		std::scoped_lock<std::mutex> guard(_sessions_mutex);
 
-		return true;
+		return _sessions;
 	}
 
 	void messaging_server::connect_condition(std::shared_ptr<messaging_session> target, const bool& condition)
@@ -347,6 +424,8 @@ namespace network
 
 		if (!condition)
 		{
+			std::scoped_lock<std::mutex> guard(_sessions_mutex);
+
 			auto iter = std::find(_sessions.begin(), _sessions.end(), target);
 			if (iter != _sessions.end())
 			{
@@ -354,14 +433,20 @@ namespace network
 			}
 		}
 
-		std::thread thread([this](const std::wstring& target_id, const std::wstring& target_sub_id, const bool& connection)
+		if (!_connection)
+		{
+			return;
+		}
+
+		std::wstring target_id = target->target_id();
+		std::wstring target_sub_id = target->target_sub_id();
+		_event_dispatcher->push([this, target_id, target_sub_id, condition](void)
 			{
 				if (_connection)
 				{
-					_connection(target_id, target_sub_id, connection);
+					_connection(target_id, target_sub_id, condition);
 				}
-			}, target->target_id(), target->target_sub_id(), condition);
-		thread.detach();
+			});
 	}
 
 	void messaging_server::received_message(std::shared_ptr<container::value_container> message)
@@ -2,8 +2,13 @@
 
 #include "container.h"
 #include "session_types.h"
-#include "thread_pool.h"
+#include "codec_types.h"
+#include "rtt_tracker.h"
+#include "event_dispatcher.h"
+#include "timer_scheduler.h"
 
+#include <map>
+#include <mutex>
 #include <memory>
 #include <vector>
 #include <string>
@@ -32,6 +37,13 @@ namespace network
 		void set_ignore_snipping_targets(const std::vector<std::wstring>& ignore_snipping_targets);
 		void set_possible_session_types(const std::vector<session_types>& possible_session_types);
 		void set_session_limit_count(const bool& session_limit_count);
+		void set_idle_timeout(const unsigned short& idle_timeout_seconds);
+		void set_echo_missing_limit(const unsigned short& echo_missing_limit);
+		void set_batch_mode(const bool& batch_mode, const unsigned short& window_milliseconds = 5, const size_t& window_bytes = 65536);
+		void set_stream_compression(const bool& stream_compression);
+		void set_compression_dictionary(const std::vector<unsigned char>& dictionary);
+		void set_compression_threshold(const size_t& minimum_bytes);
+		void set_codec(const compressing::codec_types& codec, const int& level = 0);
 
 	public:
 		void set_connection_notification(const std::function<void(const std::wstring&, const std::wstring&, const bool&)>& notification);
@@ -44,6 +56,10 @@ namespace network
 		void wait_stop(const unsigned int& seconds = 0);
 		void stop(void);
 
+	public:
+		size_t active_timer_count(void);
+		std::map<std::wstring, rtt_statistics> round_trip_statistics(void);
+
 	public:
 		void echo(void);
 		void send(const container::value_container& message);
@@ -52,10 +68,12 @@ namespace network
 		void send_files(std::shared_ptr<container::value_container> message);
 		void send_binary(const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data);
 		void send_binary(const std::wstring source_id, const std::wstring& source_sub_id, const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data);
+		void send_binary(const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data);
+		void send_binary(const std::string& source_id, const std::string& source_sub_id, const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data);
 
 	protected:
 		void wait_connection(void);
-		bool check_confirm_condition(void);
+		std::vector<std::shared_ptr<messaging_session>> current_sessions(void);
 		void connect_condition(std::shared_ptr<messaging_session> target, const bool& condition);
 
 	private:
@@ -65,12 +83,22 @@ namespace network
 	private:
 		bool _encrypt_mode;
 		bool _compress_mode;
+		bool _batch_mode;
+		unsigned short _batch_window_milliseconds;
+		size_t _batch_window_bytes;
+		bool _stream_compression;
+		std::vector<unsigned char> _compression_dictionary;
+		size_t _compression_threshold;
+		compressing::codec_types _codec;
+		int _codec_level;
 		std::wstring _source_id;
 		std::wstring _connection_key;
 		unsigned short _high_priority;
 		unsigned short _normal_priority;
 		unsigned short _low_priority;
 		size_t _session_limit_count;
+		unsigned short _idle_timeout_seconds;
+		unsigned short _echo_missing_limit;
 		std::vector<std::wstring> _ignore_target_ids;
 		std::vector<std::wstring> _ignore_snipping_targets;
 		std::vector<session_types> _possible_session_types;
@@ -79,10 +107,13 @@ namespace network
 		std::thread _thread;
 		std::shared_ptr<asio::io_context> _io_context;
 		std::shared_ptr<asio::ip::tcp::acceptor> _acceptor;
+		std::shared_ptr<timer_scheduler> _timer_scheduler;
+		std::shared_ptr<event_dispatcher> _event_dispatcher;
 
 	private:
 		std::promise<bool> _promise_status;
 		std::future<bool> _future_status;
+		std::mutex _sessions_mutex;
 		std::vector<std::shared_ptr<messaging_session>> _sessions;
 
 	private:
@@ -90,8 +121,5 @@ namespace network
 		std::function<void(std::shared_ptr<container::value_container>)> _received_message;
 		std::function<void(const std::wstring&, const std::wstring&, const std::wstring&, const std::wstring&)> _received_file;
 		std::function<void(const std::wstring&, const std::wstring&, const std::wstring&, const std::wstring&, const std::vector<unsigned char>&)> _received_data;
-
-	private:
-		std::shared_ptr<threads::thread_pool> _thread_pool;
 	};
 }
\ No newline at end of file
@@ -1,6 +1,12 @@
 ﻿#include "messaging_session.h"
 
+#include "messages.h"
+
 #include "values/bool_value.h"
+#include "values/int_value.h"
+#include "values/llong_value.h"
+#include "values/uint_value.h"
+#include "values/ushort_value.h"
 #include "values/string_value.h"
 #include "values/container_value.h"
 
@@ -8,6 +14,7 @@
 #include "converting.h"
 #include "encrypting.h"
 #include "compressing.h"
+#include "codec_registry.h"
 #include "thread_pool.h"
 #include "thread_worker.h"
 #include "job_pool.h"
@@ -32,6 +39,10 @@ namespace network
 		: data_handling(246, 135), _confirm(session_conditions::waiting), _compress_mode(false), _encrypt_mode(false), _bridge_line(false), _received_message(nullptr),
 		_key(L""), _iv(L""), _thread_pool(nullptr), _source_id(source_id), _source_sub_id(L""), _target_id(L""), _target_sub_id(L""), 
 		_connection_key(connection_key), _received_file(nullptr), _received_data(nullptr), _connection(nullptr), _kill_code(false),
+		_idle_timeout_seconds(0), _confirm_timer_id(0), _idle_timer_id(0),
+		_echo_timer_id(0), _auto_echo(false), _auto_echo_interval_seconds(1), _echo_missing_limit(3),
+		_batch_mode(false), _batch_scheduled(false), _batch_window_milliseconds(5), _batch_window_bytes(65536),
+		_stream_compression(false), _codec(codec_types::lz4), _codec_level(0), _stream_compressor(nullptr), _stream_decompressor(nullptr),
 		_socket(std::make_shared<asio::ip::tcp::socket>(std::move(socket)))
 	{
 		_socket->set_option(asio::ip::tcp::no_delay(true));
@@ -43,6 +54,10 @@ namespace network
 		_target_sub_id = fmt::format(L"{}:{}",
 			converter::to_wstring(_socket->remote_endpoint().address().to_string()), _socket->remote_endpoint().port());
 
+		_utf8_source_id = converter::to_string(_source_id);
+		_utf8_source_sub_id = converter::to_string(_source_sub_id);
+		_utf8_target_sub_id = converter::to_string(_target_sub_id);
+
 		_message_handlers.insert({ L"request_connection", std::bind(&messaging_session::connection_message, this, std::placeholders::_1) });
 		_message_handlers.insert({ L"request_files", std::bind(&messaging_session::request_files, this, std::placeholders::_1) });
 		_message_handlers.insert({ L"echo", std::bind(&messaging_session::echo_message, this, std::placeholders::_1) });
@@ -72,6 +87,49 @@ namespace network
 		_kill_code = kill_code;
 	}
 
+	void messaging_session::set_idle_timeout(const unsigned short& idle_timeout_seconds)
+	{
+		_idle_timeout_seconds = idle_timeout_seconds;
+	}
+
+	void messaging_session::set_echo_missing_limit(const unsigned short& echo_missing_limit)
+	{
+		_echo_missing_limit = echo_missing_limit;
+	}
+
+	void messaging_session::set_timer_scheduler(std::shared_ptr<timer_scheduler> scheduler)
+	{
+		_timer_scheduler = scheduler;
+	}
+
+	void messaging_session::set_batch_mode(const bool& batch_mode, const unsigned short& window_milliseconds, const size_t& window_bytes)
+	{
+		_batch_mode = batch_mode;
+		_batch_window_milliseconds = window_milliseconds;
+		_batch_window_bytes = window_bytes;
+	}
+
+	void messaging_session::set_stream_compression(const bool& stream_compression)
+	{
+		_stream_compression = stream_compression;
+	}
+
+	void messaging_session::set_compression_dictionary(const std::vector<unsigned char>& dictionary)
+	{
+		_compression_dictionary = dictionary;
+	}
+
+	void messaging_session::set_compression_threshold(const size_t& minimum_bytes)
+	{
+		_adaptive_compressor.set_minimum_bytes(minimum_bytes);
+	}
+
+	void messaging_session::set_codec(const compressing::codec_types& codec, const int& level)
+	{
+		_codec = codec;
+		_codec_level = level;
+	}
+
 	void messaging_session::set_ignore_target_ids(const std::vector<std::wstring>& ignore_target_ids)
 	{
 		_ignore_target_ids = ignore_target_ids;
@@ -122,6 +180,11 @@ namespace network
 		return _target_sub_id;
 	}
 
+	rtt_statistics messaging_session::round_trip_statistics(void)
+	{
+		return _rtt_tracker.statistics();
+	}
+
 	void messaging_session::start(const bool& encrypt_mode, const bool& compress_mode, const std::vector<session_types>& possible_session_types, 
 		const unsigned short& high_priority, const unsigned short& normal_priority, const unsigned short& low_priority)
 	{
@@ -146,7 +209,37 @@ namespace network
 			_thread_pool->append(std::make_shared<thread_worker>(priorities::low, std::vector<priorities> { priorities::high, priorities::normal }), true);
 		}
 
-		_thread_pool->push(std::make_shared<job>(priorities::high, std::bind(&messaging_session::check_confirm_condition, this)));
+		std::atomic_store(&_stream_compressor, std::shared_ptr<stream_compressor>(nullptr));
+		std::atomic_store(&_stream_decompressor, std::make_shared<stream_decompressor>(_compression_dictionary));
+
+		_last_received_time.store(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+
+		std::shared_ptr<timer_scheduler> scheduler = _timer_scheduler.lock();
+		if (scheduler != nullptr)
+		{
+			std::weak_ptr<messaging_session> session = get_ptr();
+
+			_confirm_timer_id.store(scheduler->start_timer(std::chrono::seconds(1), [session](void)
+				{
+					std::shared_ptr<messaging_session> current_session = session.lock();
+					if (current_session != nullptr)
+					{
+						current_session->check_confirm_condition();
+					}
+				}));
+
+			if (_idle_timeout_seconds > 0)
+			{
+				_idle_timer_id.store(scheduler->start_timer(std::chrono::seconds(_idle_timeout_seconds), [session](void)
+					{
+						std::shared_ptr<messaging_session> current_session = session.lock();
+						if (current_session != nullptr)
+						{
+							current_session->check_idle_condition();
+						}
+					}));
+			}
+		}
 
 		read_start_code(_socket);
 
@@ -156,6 +249,13 @@ namespace network
 
 	void messaging_session::stop(void)
 	{
+		stop_timers();
+
+		std::unique_lock<std::mutex> unique(_batch_mutex);
+		_batch_buffer.clear();
+		_batch_scheduled = false;
+		unique.unlock();
+
 		if (_thread_pool != nullptr)
 		{
 			_thread_pool->stop();
@@ -165,8 +265,12 @@ namespace network
 
 	void messaging_session::echo(void)
 	{
+		long long echo_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
 		std::shared_ptr<container::value_container> container = std::make_shared<container::value_container>(_source_id, _source_sub_id, _target_id, _target_sub_id, L"echo",
-			std::vector<std::shared_ptr<container::value>> {});
+			std::vector<std::shared_ptr<container::value>> {
+				std::make_shared<container::llong_value>(L"echo_time", echo_time)
+		});
 
 		send(container);
 	}
@@ -188,6 +292,20 @@ namespace network
 			return;
 		}
 
+		if (_batch_mode)
+		{
+			append_batch(message);
+
+			return;
+		}
+
+		if (_compress_mode && !_encrypt_mode && std::atomic_load(&_stream_compressor) != nullptr)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::top, message->serialize_array(), std::bind(&messaging_session::send_stream_packet, this, std::placeholders::_1)));
+
+			return;
+		}
+
 		if (_compress_mode)
 		{
 			_thread_pool->push(std::make_shared<job>(priorities::high, message->serialize_array(), std::bind(&messaging_session::compress_packet, this, std::placeholders::_1)));
@@ -245,6 +363,16 @@ namespace network
 	}
 
 	void messaging_session::send_binary(const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data)
+	{
+		send_binary(converter::to_string(target_id), converter::to_string(target_sub_id), data);
+	}
+
+	void messaging_session::send_binary(const std::wstring source_id, const std::wstring& source_sub_id, const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data)
+	{
+		send_binary(converter::to_string(source_id), converter::to_string(source_sub_id), converter::to_string(target_id), converter::to_string(target_sub_id), data);
+	}
+
+	void messaging_session::send_binary(const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data)
 	{
 		if (data.empty())
 		{
@@ -256,19 +384,19 @@ namespace network
 			return;
 		}
 
-		if (!_bridge_line && target_id != _target_id)
+		if (!_bridge_line && target_id != _utf8_target_id)
 		{
 			return;
 		}
 
-		if (!_bridge_line && !target_sub_id.empty() && target_id != _target_sub_id)
+		if (!_bridge_line && !target_sub_id.empty() && target_id != _utf8_target_sub_id)
 		{
 			return;
 		}
 
 		std::vector<unsigned char> result;
-		append_binary_on_packet(result, converter::to_array(_source_id));
-		append_binary_on_packet(result, converter::to_array(_source_sub_id));
+		append_binary_on_packet(result, converter::to_array(_utf8_source_id));
+		append_binary_on_packet(result, converter::to_array(_utf8_source_sub_id));
 		append_binary_on_packet(result, converter::to_array(target_id));
 		append_binary_on_packet(result, converter::to_array(target_sub_id));
 		append_binary_on_packet(result, data);
@@ -290,7 +418,7 @@ namespace network
 		_thread_pool->push(std::make_shared<job>(priorities::top, result, std::bind(&messaging_session::send_binary_packet, this, std::placeholders::_1)));
 	}
 
-	void messaging_session::send_binary(const std::wstring source_id, const std::wstring& source_sub_id, const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data)
+	void messaging_session::send_binary(const std::string& source_id, const std::string& source_sub_id, const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data)
 	{
 		if (data.empty())
 		{
@@ -302,12 +430,12 @@ namespace network
 			return;
 		}
 
-		if (!_bridge_line && target_id != _target_id)
+		if (!_bridge_line && target_id != _utf8_target_id)
 		{
 			return;
 		}
 
-		if (!_bridge_line && !target_sub_id.empty() && target_id != _target_sub_id)
+		if (!_bridge_line && !target_sub_id.empty() && target_id != _utf8_target_sub_id)
 		{
 			return;
 		}
@@ -338,6 +466,8 @@ namespace network
 
 	void messaging_session::receive_on_tcp(const data_modes& data_mode, const std::vector<unsigned char>& data)
 	{
+		_last_received_time.store(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+
 		switch (data_mode)
 		{
 		case data_modes::packet_mode:
@@ -346,6 +476,13 @@ namespace network
 		case data_modes::file_mode:
 			_thread_pool->push(std::make_shared<job>(priorities::high, data, std::bind(&messaging_session::decrypt_file_packet, this, std::placeholders::_1)));
 			break;
+		case data_modes::batch_mode:
+			_thread_pool->push(std::make_shared<job>(priorities::high, data, std::bind(&messaging_session::decrypt_batch_packet, this, std::placeholders::_1)));
+			break;
+		case data_modes::stream_mode:
+			// every stream frame depends on the ones before it, so it is decoded here in arrival order
+			decompress_stream_packet(data);
+			break;
 		}
 
 	}
@@ -360,18 +497,138 @@ namespace network
 		}
 	}
 
-	bool messaging_session::check_confirm_condition(void)
+	void messaging_session::check_confirm_condition(void)
 	{
-		std::this_thread::sleep_for(std::chrono::seconds(1));
+		_confirm_timer_id.store(0);
 
 		if (_confirm == session_conditions::confirmed)
 		{
-			return true;
+			return;
 		}
 
 		_confirm = session_conditions::expired;
 
-		return true;
+		logger::handle().write(logging::logging_level::information, fmt::format(L"expired session: {}", _target_sub_id));
+
+		if (_connection)
+		{
+			_connection(get_ptr(), false);
+		}
+	}
+
+	void messaging_session::check_idle_condition(void)
+	{
+		_idle_timer_id.store(0);
+
+		long long now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		long long idle_timeout = (long long)_idle_timeout_seconds * 1000;
+		long long elapsed = now - _last_received_time.load();
+
+		if (elapsed >= idle_timeout)
+		{
+			logger::handle().write(logging::logging_level::information, fmt::format(L"closed idle session: {}[{}] after {} ms", _target_id, _target_sub_id, elapsed));
+
+			if (_socket != nullptr && _socket->is_open())
+			{
+				_socket->close();
+			}
+
+			return;
+		}
+
+		std::shared_ptr<timer_scheduler> scheduler = _timer_scheduler.lock();
+		if (scheduler == nullptr || _socket == nullptr || !_socket->is_open())
+		{
+			return;
+		}
+
+		std::weak_ptr<messaging_session> session = get_ptr();
+		_idle_timer_id.store(scheduler->start_timer(std::chrono::milliseconds(idle_timeout - elapsed), [session](void)
+			{
+				std::shared_ptr<messaging_session> current_session = session.lock();
+				if (current_session != nullptr)
+				{
+					current_session->check_idle_condition();
+				}
+			}));
+	}
+
+	void messaging_session::stop_timers(void)
+	{
+		std::shared_ptr<timer_scheduler> scheduler = _timer_scheduler.lock();
+		if (scheduler == nullptr)
+		{
+			return;
+		}
+
+		// the io thread clears and rearms these from the timer callbacks, so each id is taken exactly once
+		unsigned long long timer_id = _confirm_timer_id.exchange(0);
+		if (timer_id != 0)
+		{
+			scheduler->stop_timer(timer_id);
+		}
+
+		timer_id = _idle_timer_id.exchange(0);
+		if (timer_id != 0)
+		{
+			scheduler->stop_timer(timer_id);
+		}
+
+		timer_id = _echo_timer_id.exchange(0);
+		if (timer_id != 0)
+		{
+			scheduler->stop_timer(timer_id);
+		}
+	}
+
+	void messaging_session::start_heartbeat(void)
+	{
+		if (!_auto_echo || _auto_echo_interval_seconds == 0)
+		{
+			return;
+		}
+
+		std::shared_ptr<timer_scheduler> scheduler = _timer_scheduler.lock();
+		if (scheduler == nullptr)
+		{
+			return;
+		}
+
+		std::weak_ptr<messaging_session> session = get_ptr();
+		_echo_timer_id.store(scheduler->start_timer(std::chrono::seconds(_auto_echo_interval_seconds), [session](void)
+			{
+				std::shared_ptr<messaging_session> current_session = session.lock();
+				if (current_session != nullptr)
+				{
+					current_session->send_heartbeat();
+				}
+			}));
+	}
+
+	void messaging_session::send_heartbeat(void)
+	{
+		_echo_timer_id.store(0);
+
+		if (_confirm != session_conditions::confirmed || _socket == nullptr || !_socket->is_open())
+		{
+			return;
+		}
+
+		if (!_rtt_tracker.sent_echo(_echo_missing_limit))
+		{
+			logger::handle().write(logging::logging_level::information, fmt::format(L"closed dead session: {}[{}] missed {} echoes", 
+				_target_id, _target_sub_id, _echo_missing_limit));
+
+			if (_socket != nullptr && _socket->is_open())
+			{
+				_socket->close();
+			}
+
+			return;
+		}
+
+		echo();
+		start_heartbeat();
 	}
 
 	bool messaging_session::contained_snipping_target(const std::wstring& snipping_target)
@@ -385,6 +642,70 @@ namespace network
 		return true;
 	}
 
+	void messaging_session::append_batch(std::shared_ptr<container::value_container> message)
+	{
+		std::unique_lock<std::mutex> unique(_batch_mutex);
+		append_binary_on_packet(_batch_buffer, message->serialize_array());
+		if (_batch_buffer.size() < _batch_window_bytes && _batch_scheduled)
+		{
+			return;
+		}
+
+		std::shared_ptr<timer_scheduler> scheduler = _timer_scheduler.lock();
+		if (_batch_buffer.size() >= _batch_window_bytes || _batch_window_milliseconds == 0 || scheduler == nullptr)
+		{
+			unique.unlock();
+
+			flush_batch();
+
+			return;
+		}
+
+		_batch_scheduled = true;
+		unique.unlock();
+
+		std::weak_ptr<messaging_session> session = get_ptr();
+		scheduler->start_timer(std::chrono::milliseconds(_batch_window_milliseconds), [session](void)
+			{
+				std::shared_ptr<messaging_session> current_session = session.lock();
+				if (current_session != nullptr)
+				{
+					current_session->flush_batch();
+				}
+			});
+	}
+
+	void messaging_session::flush_batch(void)
+	{
+		std::vector<unsigned char> batch;
+
+		std::unique_lock<std::mutex> unique(_batch_mutex);
+		batch.swap(_batch_buffer);
+		_batch_scheduled = false;
+		unique.unlock();
+
+		if (batch.empty() || _thread_pool == nullptr)
+		{
+			return;
+		}
+
+		if (_compress_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::high, batch, std::bind(&messaging_session::compress_batch_packet, this, std::placeholders::_1)));
+
+			return;
+		}
+
+		if (_encrypt_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::normal, batch, std::bind(&messaging_session::encrypt_batch_packet, this, std::placeholders::_1)));
+
+			return;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::top, batch, std::bind(&messaging_session::send_batch_packet, this, std::placeholders::_1)));
+	}
+
 	bool messaging_session::compress_packet(const std::vector<unsigned char>& data)
 	{
 		if (data.empty())
@@ -394,12 +715,12 @@ namespace network
 
 		if (_encrypt_mode)
 		{
-			_thread_pool->push(std::make_shared<job>(priorities::normal, compressor::compression(data), std::bind(&messaging_session::encrypt_packet, this, std::placeholders::_1)));
+			_thread_pool->push(std::make_shared<job>(priorities::normal, _adaptive_compressor.compression(data, (unsigned char)data_modes::packet_mode), std::bind(&messaging_session::encrypt_packet, this, std::placeholders::_1)));
 
 			return true;
 		}
 
-		_thread_pool->push(std::make_shared<job>(priorities::top, compressor::compression(data), std::bind(&messaging_session::send_packet, this, std::placeholders::_1)));
+		_thread_pool->push(std::make_shared<job>(priorities::top, _adaptive_compressor.compression(data, (unsigned char)data_modes::packet_mode), std::bind(&messaging_session::send_packet, this, std::placeholders::_1)));
 
 		return true;
 	}
@@ -477,6 +798,8 @@ namespace network
 			return false;
 		}
 
+		message->set_arena_mode(true);
+
 		auto target = _message_handlers.find(message->message_type());
 		if (target == _message_handlers.end())
 		{
@@ -537,12 +860,12 @@ namespace network
 
 		if (_encrypt_mode)
 		{
-			_thread_pool->push(std::make_shared<job>(priorities::high, compressor::compression(data), std::bind(&messaging_session::encrypt_file_packet, this, std::placeholders::_1)));
+			_thread_pool->push(std::make_shared<job>(priorities::high, _adaptive_compressor.compression(data, (unsigned char)data_modes::file_mode), std::bind(&messaging_session::encrypt_file_packet, this, std::placeholders::_1)));
 
 			return true;
 		}
 
-		_thread_pool->push(std::make_shared<job>(priorities::top, compressor::compression(data), std::bind(&messaging_session::send_file_packet, this, std::placeholders::_1)));
+		_thread_pool->push(std::make_shared<job>(priorities::top, _adaptive_compressor.compression(data, (unsigned char)data_modes::file_mode), std::bind(&messaging_session::send_file_packet, this, std::placeholders::_1)));
 
 		return true;
 	}
@@ -671,12 +994,12 @@ namespace network
 
 		if (_encrypt_mode)
 		{
-			_thread_pool->push(std::make_shared<job>(priorities::normal, compressor::compression(data), std::bind(&messaging_session::encrypt_binary_packet, this, std::placeholders::_1)));
+			_thread_pool->push(std::make_shared<job>(priorities::normal, _adaptive_compressor.compression(data, (unsigned char)data_modes::binary_mode), std::bind(&messaging_session::encrypt_binary_packet, this, std::placeholders::_1)));
 
 			return true;
 		}
 
-		_thread_pool->push(std::make_shared<job>(priorities::top, compressor::compression(data), std::bind(&messaging_session::send_binary_packet, this, std::placeholders::_1)));
+		_thread_pool->push(std::make_shared<job>(priorities::top, _adaptive_compressor.compression(data, (unsigned char)data_modes::binary_mode), std::bind(&messaging_session::send_binary_packet, this, std::placeholders::_1)));
 
 		return true;
 	}
@@ -762,6 +1085,147 @@ namespace network
 		return true;
 	}
 
+	bool messaging_session::compress_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		if (_encrypt_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::normal, _adaptive_compressor.compression(data, (unsigned char)data_modes::batch_mode), std::bind(&messaging_session::encrypt_batch_packet, this, std::placeholders::_1)));
+
+			return true;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::top, _adaptive_compressor.compression(data, (unsigned char)data_modes::batch_mode), std::bind(&messaging_session::send_batch_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
+	bool messaging_session::encrypt_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::top, encryptor::encryption(data, _key, _iv), std::bind(&messaging_session::send_batch_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
+	bool messaging_session::send_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		return send_on_tcp(_socket, data_modes::batch_mode, data);
+	}
+
+	bool messaging_session::decompress_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		if (_compress_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::normal, compressor::decompression(data), std::bind(&messaging_session::receive_batch_packet, this, std::placeholders::_1)));
+
+			return true;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::high, data, std::bind(&messaging_session::receive_batch_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
+	bool messaging_session::decrypt_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		if (_encrypt_mode)
+		{
+			_thread_pool->push(std::make_shared<job>(priorities::high, encryptor::decryption(data, _key, _iv), std::bind(&messaging_session::decompress_batch_packet, this, std::placeholders::_1)));
+
+			return true;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::high, data, std::bind(&messaging_session::decompress_batch_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
+	bool messaging_session::receive_batch_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		// messages are handed over one by one in this job, so their order within the batch is kept
+		size_t index = 0;
+		std::vector<unsigned char> packet = devide_binary_on_packet(data, index);
+		while (!packet.empty())
+		{
+			receive_packet(packet);
+			packet = devide_binary_on_packet(data, index);
+		}
+
+		return true;
+	}
+
+	bool messaging_session::send_stream_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		// compressed in the send job itself: the single top worker keeps the stream in wire order
+		std::shared_ptr<stream_compressor> stream = std::atomic_load(&_stream_compressor);
+		if (stream == nullptr)
+		{
+			return false;
+		}
+
+		return send_on_tcp(_socket, data_modes::stream_mode, stream->compression(data));
+	}
+
+	bool messaging_session::decompress_stream_packet(const std::vector<unsigned char>& data)
+	{
+		if (data.empty())
+		{
+			return false;
+		}
+
+		std::shared_ptr<stream_decompressor> stream = std::atomic_load(&_stream_decompressor);
+		if (stream == nullptr)
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot decompress stream packet without stream context");
+
+			return false;
+		}
+
+		std::vector<unsigned char> decompressed_data = stream->decompression(data);
+		if (decompressed_data.empty())
+		{
+			return false;
+		}
+
+		_thread_pool->push(std::make_shared<job>(priorities::high, decompressed_data, std::bind(&messaging_session::receive_packet, this, std::placeholders::_1)));
+
+		return true;
+	}
+
 	bool messaging_session::normal_message(std::shared_ptr<container::value_container> message)
 	{
 		if (message == nullptr)
@@ -789,8 +1253,17 @@ namespace network
 			return false;
 		}
 
+		request_connection request;
+		if (!container::message_schema<request_connection>::from_container(message, request))
+		{
+			return false;
+		}
+
 		_target_id = message->source_id();
-		_session_type = (session_types)message->get_value(L"session_type")->to_short();
+		_utf8_target_id = converter::to_string(_target_id);
+		_session_type = (session_types)request.session_type;
+		_auto_echo = request.auto_echo;
+		_auto_echo_interval_seconds = request.auto_echo_interval_seconds;
 
 		if (_source_id == _target_id)
 		{
@@ -818,7 +1291,7 @@ namespace network
 		}
 
 		// check connection key
-		if (!same_key_check(message->get_value(L"connection_key")))
+		if (!same_key_check(request.connection_key))
 		{
 			_confirm = session_conditions::expired;
 
@@ -835,54 +1308,85 @@ namespace network
 
 		_confirm = session_conditions::confirmed;
 
+		std::shared_ptr<timer_scheduler> scheduler = _timer_scheduler.lock();
+		unsigned long long confirm_timer_id = _confirm_timer_id.exchange(0);
+		if (scheduler != nullptr && confirm_timer_id != 0)
+		{
+			scheduler->stop_timer(confirm_timer_id);
+		}
+
 		// check snipping target list
 		std::shared_ptr<value> acceptable_snipping_targets = std::make_shared<container::container_value>(L"snipping_targets");
 
 		_snipping_targets.clear();		
-		std::vector<std::shared_ptr<value>> snipping_targets = message->get_value(L"snipping_targets")->children();
-		for (auto& snipping_target : snipping_targets)
+		for (auto& snipping_target : request.snipping_targets)
 		{
-			if (snipping_target == nullptr)
-			{
-				continue;
-			}
-
-			if (snipping_target->name() != L"snipping_target")
-			{
-				continue;
-			}
-
-			auto target = std::find(_ignore_snipping_targets.begin(), _ignore_snipping_targets.end(), snipping_target->to_string());
+			auto target = std::find(_ignore_snipping_targets.begin(), _ignore_snipping_targets.end(), snipping_target);
 			if (target == _snipping_targets.end())
 			{
 				continue;
 			}
 
-			_snipping_targets.push_back(snipping_target->to_string());
+			_snipping_targets.push_back(snipping_target);
 
-			acceptable_snipping_targets->add(std::make_shared<container::string_value>(L"snipping_target", snipping_target->to_string()));
+			acceptable_snipping_targets->add(std::make_shared<container::string_value>(L"snipping_target", snipping_target));
 		}
 
 		generate_key();
 
+		// stream frames skip the job pool stages, so they are only used when nothing has to be encrypted
+		bool stream_compression = _compress_mode && !_encrypt_mode && _stream_compression && request.stream_compression;
+		unsigned int dictionary_id = compressor::dictionary_id(_compression_dictionary);
+		if (request.dictionary_id != dictionary_id)
+		{
+			dictionary_id = 0;
+		}
+
+		if (stream_compression)
+		{
+			std::atomic_store(&_stream_compressor, std::make_shared<stream_compressor>(dictionary_id != 0 ? _compression_dictionary : std::vector<unsigned char>()));
+		}
+
+		// a client asking for more than plain lz4 gets its codec, otherwise the one set on this side is used;
+		// either way only a codec both sides have is agreed
+		codec_types codec = (codec_types)request.codec;
+		int codec_level = request.codec_level;
+		if (codec == codec_types::lz4)
+		{
+			codec = _codec;
+			codec_level = _codec_level;
+		}
+
+		codec_types agreed_codec = codec_registry::negotiate(codec, request.codecs);
+		codec_level = codec_registry::level(agreed_codec, (agreed_codec == codec) ? codec_level : 0);
+		_adaptive_compressor.set_codec(agreed_codec, codec_level);
+		_adaptive_compressor.set_peer_codecs(request.codecs);
+
 		std::shared_ptr<container::value_container> container = std::make_shared<container::value_container>(_source_id, _source_sub_id, _target_id, _target_sub_id, L"confirm_connection",
 			std::vector<std::shared_ptr<container::value>> {
 				std::make_shared<container::bool_value>(L"confirm", true),
 				std::make_shared<container::string_value>(L"key", _key),
 				std::make_shared<container::string_value>(L"iv", _iv),
 				std::make_shared<container::bool_value>(L"encrypt_mode", _encrypt_mode),
+				std::make_shared<container::bool_value>(L"stream_compression", stream_compression),
+				std::make_shared<container::uint_value>(L"dictionary_id", dictionary_id),
+				std::make_shared<container::ushort_value>(L"codec", (unsigned short)agreed_codec),
+				std::make_shared<container::int_value>(L"codec_level", codec_level),
+				std::make_shared<container::uint_value>(L"codecs", codec_registry::registered_codecs()),
 				acceptable_snipping_targets
 		});
 
 		if (_compress_mode)
 		{
-			_thread_pool->push(std::make_shared<job>(priorities::high, compressor::compression(container->serialize_array()), std::bind(&messaging_session::send_packet, this, std::placeholders::_1)));
+			_thread_pool->push(std::make_shared<job>(priorities::high, _adaptive_compressor.compression(container->serialize_array(), (unsigned char)data_modes::packet_mode), std::bind(&messaging_session::send_packet, this, std::placeholders::_1)));
 
 			if (_connection)
 			{
 				_connection(get_ptr(), true);
 			}
 
+			start_heartbeat();
+
 			return true;
 		}
 
@@ -893,6 +1397,8 @@ namespace network
 			_connection(get_ptr(), true);
 		}
 
+		start_heartbeat();
+
 		return true;
 	}
 
@@ -941,7 +1447,19 @@ namespace network
 		std::vector<std::shared_ptr<value>> response = (*message)[L"response"];
 		if (!response.empty())
 		{
-			logger::handle().write(logging::logging_level::information, fmt::format(L"received echo: {}", message->serialize()));
+			std::shared_ptr<value> echo_time = message->get_value(L"echo_time");
+			if (!echo_time->is_numeric())
+			{
+				logger::handle().write(logging::logging_level::information, fmt::format(L"received echo: {}", message->serialize()));
+
+				return true;
+			}
+
+			long long now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			double rtt_ms = (double)(now - echo_time->to_llong()) / 1000.0;
+			_rtt_tracker.received_echo(rtt_ms);
+
+			logger::handle().write(logging::logging_level::sequence, fmt::format(L"received echo from {}[{}]: rtt {:.3f} ms", _target_id, _target_sub_id, rtt_ms));
 
 			return true;
 		}
@@ -950,7 +1468,7 @@ namespace network
 
 		message << std::make_shared<bool_value>(L"response", true);
 
-		_thread_pool->push(std::make_shared<job>(priorities::top, message->serialize_array(), std::bind(&messaging_session::send_packet, this, std::placeholders::_1)));
+		send(message);
 
 		return true;
 	}
@@ -970,9 +1488,9 @@ namespace network
 		_iv = encrypt_key.second;
 	}
 
-	bool messaging_session::same_key_check(std::shared_ptr<container::value> key)
+	bool messaging_session::same_key_check(const std::wstring& key)
 	{
-		if (key != nullptr && _connection_key == key->to_string())
+		if (_connection_key == key)
 		{
 			return true;
 		}
@@ -3,9 +3,16 @@
 #include "container.h"
 #include "thread_pool.h"
 #include "data_handling.h"
+#include "adaptive_compressor.h"
+#include "stream_compressor.h"
+#include "stream_decompressor.h"
 #include "session_types.h"
+#include "timer_scheduler.h"
+#include "rtt_tracker.h"
 
 #include <map>
+#include <mutex>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <functional>
@@ -25,6 +32,14 @@ namespace network
 
 	public:
 		void set_kill_code(const bool& kill_code);
+		void set_idle_timeout(const unsigned short& idle_timeout_seconds);
+		void set_echo_missing_limit(const unsigned short& echo_missing_limit);
+		void set_timer_scheduler(std::shared_ptr<timer_scheduler> scheduler);
+		void set_batch_mode(const bool& batch_mode, const unsigned short& window_milliseconds = 5, const size_t& window_bytes = 65536);
+		void set_stream_compression(const bool& stream_compression);
+		void set_compression_dictionary(const std::vector<unsigned char>& dictionary);
+		void set_compression_threshold(const size_t& minimum_bytes);
+		void set_codec(const compressing::codec_types& codec, const int& level = 0);
 		void set_ignore_target_ids(const std::vector<std::wstring>& ignore_target_ids);
 		void set_ignore_snipping_targets(const std::vector<std::wstring>& ignore_snipping_targets);
 		void set_connection_notification(const std::function<void(std::shared_ptr<messaging_session>, const bool&)>& notification);
@@ -37,6 +52,7 @@ namespace network
 		const session_types get_session_type(void);
 		const std::wstring target_id(void);
 		const std::wstring target_sub_id(void);
+		rtt_statistics round_trip_statistics(void);
 
 	public:
 		void start(const bool& encrypt_mode, const bool& compress_mode, const std::vector<session_types>& possible_session_types, 
@@ -49,14 +65,22 @@ namespace network
 		void send_files(std::shared_ptr<container::value_container> message);
 		void send_binary(const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data);
 		void send_binary(const std::wstring source_id, const std::wstring& source_sub_id, const std::wstring target_id, const std::wstring& target_sub_id, const std::vector<unsigned char>& data);
+		void send_binary(const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data);
+		void send_binary(const std::string& source_id, const std::string& source_sub_id, const std::string& target_id, const std::string& target_sub_id, const std::vector<unsigned char>& data);
 
 	protected:
 		void receive_on_tcp(const data_modes& data_mode, const std::vector<unsigned char>& data) override;
 		void disconnected(void) override;
 
 	protected:
-		bool check_confirm_condition(void);
+		void check_confirm_condition(void);
+		void check_idle_condition(void);
+		void start_heartbeat(void);
+		void send_heartbeat(void);
+		void stop_timers(void);
 		bool contained_snipping_target(const std::wstring& snipping_target);
+		void append_batch(std::shared_ptr<container::value_container> message);
+		void flush_batch(void);
 
 		// packet
 	private:
@@ -93,6 +117,22 @@ namespace network
 		bool decrypt_binary_packet(const std::vector<unsigned char>& data);
 		bool receive_binary_packet(const std::vector<unsigned char>& data);
 
+		// batch
+	private:
+		bool compress_batch_packet(const std::vector<unsigned char>& data);
+		bool encrypt_batch_packet(const std::vector<unsigned char>& data);
+		bool send_batch_packet(const std::vector<unsigned char>& data);
+
+	private:
+		bool decompress_batch_packet(const std::vector<unsigned char>& data);
+		bool decrypt_batch_packet(const std::vector<unsigned char>& data);
+		bool receive_batch_packet(const std::vector<unsigned char>& data);
+
+		// stream
+	private:
+		bool send_stream_packet(const std::vector<unsigned char>& data);
+		bool decompress_stream_packet(const std::vector<unsigned char>& data);
+
 	private:
 		bool normal_message(std::shared_ptr<container::value_container> message);
 		bool connection_message(std::shared_ptr<container::value_container> message);
@@ -101,7 +141,7 @@ namespace network
 
 	private:
 		void generate_key(void);
-		bool same_key_check(std::shared_ptr<container::value> key);
+		bool same_key_check(const std::wstring& key);
 		bool same_id_check(void);
 
 	private:
@@ -115,14 +155,44 @@ namespace network
 		std::wstring _target_id;
 		std::wstring _target_sub_id;
 		std::wstring _connection_key;
+		std::string _utf8_source_id;
+		std::string _utf8_source_sub_id;
+		std::string _utf8_target_id;
+		std::string _utf8_target_sub_id;
 		std::vector<std::wstring> _snipping_targets;
 		std::vector<std::wstring> _ignore_target_ids;
 		std::vector<std::wstring> _ignore_snipping_targets;
 		std::vector<session_types> _possible_session_types;
 
+	private:
+		unsigned short _idle_timeout_seconds;
+		std::atomic<unsigned long long> _confirm_timer_id;
+		std::atomic<unsigned long long> _idle_timer_id;
+		std::atomic<unsigned long long> _echo_timer_id;
+		unsigned short _auto_echo_interval_seconds;
+		unsigned short _echo_missing_limit;
+		rtt_tracker _rtt_tracker;
+		std::atomic<long long> _last_received_time{ 0 };
+		std::weak_ptr<timer_scheduler> _timer_scheduler;
+
+	private:
+		bool _batch_mode;
+		bool _batch_scheduled;
+		unsigned short _batch_window_milliseconds;
+		size_t _batch_window_bytes;
+		std::mutex _batch_mutex;
+		std::vector<unsigned char> _batch_buffer;
+
 	private:
 		bool _compress_mode;
 		bool _encrypt_mode;
+		bool _stream_compression;
+		std::vector<unsigned char> _compression_dictionary;
+		compressing::codec_types _codec;
+		int _codec_level;
+		std::shared_ptr<compressing::stream_compressor> _stream_compressor;
+		std::shared_ptr<compressing::stream_decompressor> _stream_decompressor;
+		compressing::adaptive_compressor _adaptive_compressor;
 		std::wstring _key;
 		std::wstring _iv;
 
@@ -0,0 +1,90 @@
+#include "rtt_tracker.h"
+
+#include <algorithm>
+
+namespace network
+{
+	rtt_tracker::rtt_tracker(const size_t& window_size, const double& ewma_weight)
+		: _window_size(window_size), _ewma_weight(ewma_weight), _waiting_echo(false)
+	{
+	}
+
+	rtt_tracker::~rtt_tracker(void)
+	{
+	}
+
+	bool rtt_tracker::sent_echo(const unsigned short& missing_limit)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		if (_waiting_echo)
+		{
+			_statistics.missed_echoes++;
+		}
+
+		_waiting_echo = true;
+
+		return missing_limit == 0 || _statistics.missed_echoes < missing_limit;
+	}
+
+	void rtt_tracker::received_echo(const double& rtt_ms)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		_waiting_echo = false;
+		_statistics.missed_echoes = 0;
+		_statistics.last_ms = rtt_ms;
+
+		if (_statistics.samples == 0)
+		{
+			_statistics.ewma_ms = rtt_ms;
+		}
+		else
+		{
+			_statistics.ewma_ms += _ewma_weight * (rtt_ms - _statistics.ewma_ms);
+		}
+		_statistics.samples++;
+
+		_samples.push_back(rtt_ms);
+		while (_samples.size() > _window_size)
+		{
+			_samples.pop_front();
+		}
+	}
+
+	void rtt_tracker::reset(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		_waiting_echo = false;
+		_statistics = rtt_statistics();
+		_samples.clear();
+	}
+
+	rtt_statistics rtt_tracker::statistics(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		rtt_statistics result = _statistics;
+		if (_samples.empty())
+		{
+			return result;
+		}
+
+		std::deque<double> sorted_samples = _samples;
+		std::sort(sorted_samples.begin(), sorted_samples.end());
+
+		result.p50_ms = percentile(sorted_samples, 0.50);
+		result.p90_ms = percentile(sorted_samples, 0.90);
+		result.p99_ms = percentile(sorted_samples, 0.99);
+
+		return result;
+	}
+
+	double rtt_tracker::percentile(const std::deque<double>& sorted_samples, const double& ratio)
+	{
+		size_t index = (size_t)(ratio * (double)(sorted_samples.size() - 1) + 0.5);
+
+		return sorted_samples[std::min(index, sorted_samples.size() - 1)];
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+
+namespace network
+{
+	struct rtt_statistics
+	{
+		unsigned long long samples = 0;
+		unsigned short missed_echoes = 0;
+		double last_ms = 0.0;
+		double ewma_ms = 0.0;
+		double p50_ms = 0.0;
+		double p90_ms = 0.0;
+		double p99_ms = 0.0;
+	};
+
+	class rtt_tracker
+	{
+	public:
+		rtt_tracker(const size_t& window_size = 128, const double& ewma_weight = 0.125);
+		~rtt_tracker(void);
+
+	public:
+		bool sent_echo(const unsigned short& missing_limit);
+		void received_echo(const double& rtt_ms);
+		void reset(void);
+
+	public:
+		rtt_statistics statistics(void);
+
+	private:
+		double percentile(const std::deque<double>& sorted_samples, const double& ratio);
+
+	private:
+		std::mutex _mutex;
+		size_t _window_size;
+		double _ewma_weight;
+		bool _waiting_echo;
+		rtt_statistics _statistics;
+		std::deque<double> _samples;
+	};
+}
@@ -0,0 +1,113 @@
+#include "timer_scheduler.h"
+
+#include "logging.h"
+
+#include "fmt/format.h"
+
+namespace network
+{
+	using namespace logging;
+
+	timer_scheduler::timer_scheduler(std::shared_ptr<asio::io_context> io_context)
+		: _io_context(io_context), _last_timer_id(0)
+	{
+	}
+
+	timer_scheduler::~timer_scheduler(void)
+	{
+		stop_all();
+	}
+
+	std::shared_ptr<timer_scheduler> timer_scheduler::get_ptr(void)
+	{
+		return shared_from_this();
+	}
+
+	unsigned long long timer_scheduler::start_timer(const std::chrono::milliseconds& duration, const std::function<void(void)>& notification)
+	{
+		if (_io_context == nullptr || notification == nullptr)
+		{
+			return 0;
+		}
+
+		std::shared_ptr<asio::steady_timer> timer = std::make_shared<asio::steady_timer>(*_io_context, duration);
+
+		std::unique_lock<std::mutex> unique(_mutex);
+		unsigned long long timer_id = ++_last_timer_id;
+		_timers.insert({ timer_id, timer });
+		unique.unlock();
+
+		std::weak_ptr<timer_scheduler> scheduler = get_ptr();
+		timer->async_wait([scheduler, timer_id, notification](const std::error_code& ec)
+			{
+				if (ec)
+				{
+					return;
+				}
+
+				std::shared_ptr<timer_scheduler> current_scheduler = scheduler.lock();
+				if (current_scheduler == nullptr)
+				{
+					return;
+				}
+
+				current_scheduler->expired(timer_id, notification);
+			});
+
+		return timer_id;
+	}
+
+	void timer_scheduler::stop_timer(const unsigned long long& timer_id)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		auto target = _timers.find(timer_id);
+		if (target == _timers.end())
+		{
+			return;
+		}
+
+		// timers are only touched on the io thread, which also runs their handlers
+		std::shared_ptr<asio::steady_timer> timer = target->second;
+		_timers.erase(target);
+
+		asio::post(*_io_context, [timer](void) { timer->cancel(); });
+	}
+
+	void timer_scheduler::stop_all(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		for (auto& timer : _timers)
+		{
+			std::shared_ptr<asio::steady_timer> target = timer.second;
+			asio::post(*_io_context, [target](void) { target->cancel(); });
+		}
+		_timers.clear();
+	}
+
+	size_t timer_scheduler::active_count(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		return _timers.size();
+	}
+
+	void timer_scheduler::expired(const unsigned long long& timer_id, const std::function<void(void)>& notification)
+	{
+		std::unique_lock<std::mutex> unique(_mutex);
+
+		auto target = _timers.find(timer_id);
+		if (target == _timers.end())
+		{
+			return;
+		}
+
+		_timers.erase(target);
+		unique.unlock();
+
+		logger::handle().write(logging::logging_level::sequence, fmt::format(L"expired timer: {}", timer_id));
+
+		notification();
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <functional>
+
+#include "asio.hpp"
+
+namespace network
+{
+	class timer_scheduler : public std::enable_shared_from_this<timer_scheduler>
+	{
+	public:
+		timer_scheduler(std::shared_ptr<asio::io_context> io_context);
+		~timer_scheduler(void);
+
+	public:
+		std::shared_ptr<timer_scheduler> get_ptr(void);
+
+	public:
+		unsigned long long start_timer(const std::chrono::milliseconds& duration, const std::function<void(void)>& notification);
+		void stop_timer(const unsigned long long& timer_id);
+		void stop_all(void);
+
+	public:
+		size_t active_count(void);
+
+	private:
+		void expired(const unsigned long long& timer_id, const std::function<void(void)>& notification);
+
+	private:
+		std::mutex _mutex;
+		unsigned long long _last_timer_id;
+		std::shared_ptr<asio::io_context> _io_context;
+		std::map<unsigned long long, std::shared_ptr<asio::steady_timer>> _timers;
+	};
+}
@@ -0,0 +1,196 @@
+#include "adaptive_compressor.h"
+
+#include "compressing.h"
+#include "codec_registry.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace compressing
+{
+	constexpr size_t ENTROPY_SAMPLE_BYTES = 1024;
+	constexpr size_t ENTROPY_SAMPLE_COUNT = 4;
+	constexpr unsigned int PROBE_INTERVAL = 16;
+	constexpr double RATIO_WEIGHT = 0.25;
+
+	adaptive_compressor::adaptive_compressor(const size_t& minimum_bytes, const double& maximum_ratio, const double& maximum_entropy)
+		: _minimum_bytes(minimum_bytes), _maximum_ratio(maximum_ratio), _maximum_entropy(maximum_entropy), _compressed_count(0), _stored_count(0),
+		_codec(codec_types::lz4), _level(0), _peer_codecs(0)
+	{
+	}
+
+	adaptive_compressor::~adaptive_compressor(void)
+	{
+	}
+
+	void adaptive_compressor::set_minimum_bytes(const size_t& minimum_bytes)
+	{
+		_minimum_bytes = minimum_bytes;
+	}
+
+	void adaptive_compressor::set_codec(const codec_types& codec, const int& level)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		_codec = codec;
+		_level = level;
+	}
+
+	void adaptive_compressor::set_peer_codecs(const unsigned int& peer_codecs)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		_peer_codecs = peer_codecs;
+	}
+
+	std::vector<unsigned char> adaptive_compressor::compression(const std::vector<unsigned char>& original_data, const unsigned char& content_type)
+	{
+		if (original_data.empty())
+		{
+			return original_data;
+		}
+
+		std::unique_lock<std::mutex> unique(_mutex);
+		codec_types codec = _codec;
+		int level = _level;
+		bool storable = (_peer_codecs & (1u << (unsigned short)codec_types::none)) != 0;
+		if ((_peer_codecs & (1u << (unsigned short)codec)) == 0)
+		{
+			// a codec the peer never announced, such as zstd, would arrive under a marker it cannot decode
+			codec = codec_types::lz4;
+			level = 0;
+		}
+		unique.unlock();
+
+		if (!storable)
+		{
+			// without stored payloads there is nothing to gain from skipping, so the baseline lz4 blocks are always sent,
+			// and never as a frame, which such a peer cannot read either
+			std::vector<unsigned char> compressed_data = compressor::chained_compression(original_data);
+
+			std::scoped_lock<std::mutex> guard(_mutex);
+			++_compressed_count;
+
+			return compressed_data;
+		}
+
+		if (codec == codec_types::none || !worth_compressing(original_data, content_type))
+		{
+			std::scoped_lock<std::mutex> guard(_mutex);
+			++_stored_count;
+
+			return compressor::store(original_data);
+		}
+
+		std::vector<unsigned char> compressed_data = codec_registry::compression(original_data, codec, level);
+		update_ratio(content_type, compressed_data.empty() ? 1.0 : (double)compressed_data.size() / (double)original_data.size());
+
+		std::scoped_lock<std::mutex> guard(_mutex);
+		if (compressed_data.empty() || compressed_data.size() >= original_data.size())
+		{
+			++_stored_count;
+
+			return compressor::store(original_data);
+		}
+
+		++_compressed_count;
+
+		return compressed_data;
+	}
+
+	size_t adaptive_compressor::compressed_count(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		return _compressed_count;
+	}
+
+	size_t adaptive_compressor::stored_count(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		return _stored_count;
+	}
+
+	bool adaptive_compressor::worth_compressing(const std::vector<unsigned char>& original_data, const unsigned char& content_type)
+	{
+		if (original_data.size() < _minimum_bytes)
+		{
+			return false;
+		}
+
+		{
+			// content that compressed badly lately is skipped, with a probe every few payloads to notice a change
+			std::scoped_lock<std::mutex> guard(_mutex);
+
+			auto target = _statistics.find(content_type);
+			if (target != _statistics.end() && target->second.ratio > _maximum_ratio && ++target->second.skipped < PROBE_INTERVAL)
+			{
+				return false;
+			}
+		}
+
+		if (sampled_entropy(original_data) > _maximum_entropy)
+		{
+			update_ratio(content_type, 1.0);
+
+			return false;
+		}
+
+		return true;
+	}
+
+	void adaptive_compressor::update_ratio(const unsigned char& content_type, const double& ratio)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		auto target = _statistics.find(content_type);
+		if (target == _statistics.end())
+		{
+			_statistics.insert({ content_type, { ratio, 0 } });
+
+			return;
+		}
+
+		target->second.ratio += (ratio - target->second.ratio) * RATIO_WEIGHT;
+		target->second.skipped = 0;
+	}
+
+	double adaptive_compressor::sampled_entropy(const std::vector<unsigned char>& original_data) const
+	{
+		// a few slices spread over the payload are enough to spot data that is already compressed or encrypted
+		size_t counts[256] = { 0, };
+		size_t total = 0;
+
+		size_t sample_bytes = (std::min)(ENTROPY_SAMPLE_BYTES, original_data.size());
+		size_t stride = (original_data.size() - sample_bytes) / ENTROPY_SAMPLE_COUNT;
+		for (size_t sample = 0; sample < ENTROPY_SAMPLE_COUNT; ++sample)
+		{
+			const unsigned char* source = original_data.data() + sample * stride;
+			for (size_t index = 0; index < sample_bytes; ++index)
+			{
+				++counts[source[index]];
+			}
+			total += sample_bytes;
+
+			if (stride == 0)
+			{
+				break;
+			}
+		}
+
+		double entropy = 0.0;
+		for (auto& count : counts)
+		{
+			if (count == 0)
+			{
+				continue;
+			}
+
+			double probability = (double)count / (double)total;
+			entropy -= probability * std::log2(probability);
+		}
+
+		return entropy;
+	}
+}
\ No newline at end of file
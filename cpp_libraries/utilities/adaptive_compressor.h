@@ -0,0 +1,55 @@
+#pragma once
+
+#include "codec_types.h"
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+namespace compressing
+{
+	// decides per payload whether compressing is worth it and stores the payload as is otherwise;
+	// compressor::decompression tells both forms apart, so receivers only decompress what was compressed.
+	// a peer that did not announce its codecs cannot read stored or framed payloads, so it always gets chained lz4 blocks
+	class adaptive_compressor
+	{
+	public:
+		adaptive_compressor(const size_t& minimum_bytes = 256, const double& maximum_ratio = 0.9, const double& maximum_entropy = 7.5);
+		~adaptive_compressor(void);
+
+	public:
+		void set_minimum_bytes(const size_t& minimum_bytes);
+		void set_codec(const codec_types& codec, const int& level = 0);
+		void set_peer_codecs(const unsigned int& peer_codecs);
+		std::vector<unsigned char> compression(const std::vector<unsigned char>& original_data, const unsigned char& content_type = 0);
+
+	public:
+		size_t compressed_count(void);
+		size_t stored_count(void);
+
+	protected:
+		bool worth_compressing(const std::vector<unsigned char>& original_data, const unsigned char& content_type);
+		void update_ratio(const unsigned char& content_type, const double& ratio);
+		double sampled_entropy(const std::vector<unsigned char>& original_data) const;
+
+	private:
+		struct content_statistics
+		{
+			double ratio;
+			unsigned int skipped;
+		};
+
+	private:
+		std::atomic<size_t> _minimum_bytes;
+		double _maximum_ratio;
+		double _maximum_entropy;
+		size_t _compressed_count;
+		size_t _stored_count;
+		codec_types _codec;
+		int _level;
+		unsigned int _peer_codecs;
+		std::mutex _mutex;
+		std::map<unsigned char, content_statistics> _statistics;
+	};
+}
@@ -0,0 +1,155 @@
+#include "codec_registry.h"
+
+#include "compressing.h"
+#include "logging.h"
+
+#include "lz4hc.h"
+#include "zstd.h"
+
+#include <cwchar>
+#include <cwctype>
+#include <algorithm>
+
+#include "fmt/format.h"
+
+namespace compressing
+{
+	using namespace logging;
+
+	std::mutex codec_registry::_mutex;
+
+	void codec_registry::register_codec(const codec_types& codec, const std::wstring& name, const int& minimum_level, const int& maximum_level, const int& default_level,
+		const std::function<std::vector<unsigned char>(const std::vector<unsigned char>&, const int&)>& compression)
+	{
+		if (compression == nullptr)
+		{
+			return;
+		}
+
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		codecs()[codec] = { name, minimum_level, maximum_level, (std::max)(minimum_level, (std::min)(default_level, maximum_level)), compression };
+	}
+
+	bool codec_registry::is_registered(const codec_types& codec)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		return codecs().find(codec) != codecs().end();
+	}
+
+	unsigned int codec_registry::registered_codecs(void)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		unsigned int result = 0;
+		for (auto& codec : codecs())
+		{
+			result |= 1u << (unsigned short)codec.first;
+		}
+
+		return result;
+	}
+
+	codec_types codec_registry::negotiate(const codec_types& requested, const unsigned int& peer_codecs)
+	{
+		// a peer that does not announce its codecs predates the registry and only decodes chained lz4 blocks,
+		// so zstd and the other markers are only agreed when the peer listed them
+		unsigned int available = registered_codecs() & ((peer_codecs == 0) ? (1u << (unsigned short)codec_types::lz4) : peer_codecs);
+		if ((available & (1u << (unsigned short)requested)) != 0)
+		{
+			return requested;
+		}
+
+		return codec_types::lz4;
+	}
+
+	std::vector<unsigned char> codec_registry::compression(const std::vector<unsigned char>& original_data, const codec_types& codec, const int& level)
+	{
+		std::unique_lock<std::mutex> unique(_mutex);
+
+		auto target = codecs().find(codec);
+		if (target == codecs().end())
+		{
+			unique.unlock();
+
+			logger::handle().write(logging::logging_level::error, fmt::format(L"unknown codec: {}, it will be compressed with lz4", (unsigned short)codec));
+
+			return compressor::compression(original_data);
+		}
+
+		auto compression = target->second.compression;
+		int selected = (level == 0) ? target->second.default_level : (std::max)(target->second.minimum_level, (std::min)(level, target->second.maximum_level));
+		unique.unlock();
+
+		return compression(original_data, selected);
+	}
+
+	int codec_registry::level(const codec_types& codec, const int& level)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		auto target = codecs().find(codec);
+		if (target == codecs().end())
+		{
+			return 0;
+		}
+
+		if (level == 0)
+		{
+			return target->second.default_level;
+		}
+
+		return (std::max)(target->second.minimum_level, (std::min)(level, target->second.maximum_level));
+	}
+
+	std::wstring codec_registry::name(const codec_types& codec)
+	{
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		auto target = codecs().find(codec);
+		if (target == codecs().end())
+		{
+			return L"";
+		}
+
+		return target->second.name;
+	}
+
+	bool codec_registry::parse(const std::wstring& source, codec_types& codec, int& level)
+	{
+		// accepts "name" or "name:level", as in "zstd:19"
+		size_t separator = source.find(L':');
+		std::wstring name = source.substr(0, separator);
+		std::transform(name.begin(), name.end(), name.begin(), ::towlower);
+
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		for (auto& target : codecs())
+		{
+			if (target.second.name != name)
+			{
+				continue;
+			}
+
+			codec = target.first;
+			level = (separator == std::wstring::npos) ? 0 : (int)std::wcstol(source.c_str() + separator + 1, nullptr, 10);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	std::map<codec_types, codec_registry::codec_entry>& codec_registry::codecs(void)
+	{
+		static std::map<codec_types, codec_entry> codecs = {
+			{ codec_types::none, { L"none", 0, 0, 0, [](const std::vector<unsigned char>& original_data, const int&) { return compressor::store(original_data); } } },
+			{ codec_types::lz4, { L"lz4", 0, 0, 0, [](const std::vector<unsigned char>& original_data, const int&) { return compressor::compression(original_data); } } },
+			{ codec_types::lz4hc, { L"lz4hc", 1, LZ4HC_CLEVEL_MAX, LZ4HC_CLEVEL_DEFAULT, &compressor::hc_compression } },
+			{ codec_types::zstd, { L"zstd", 1, ZSTD_maxCLevel(), 3, &compressor::zstd_compression } }
+		};
+
+		return codecs;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "codec_types.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace compressing
+{
+	// every codec writes a payload that compressor::decompression recognizes by its header,
+	// so a session only has to agree on what the sender uses and receivers decode any of them
+	class codec_registry
+	{
+	public:
+		static void register_codec(const codec_types& codec, const std::wstring& name, const int& minimum_level, const int& maximum_level, const int& default_level,
+			const std::function<std::vector<unsigned char>(const std::vector<unsigned char>&, const int&)>& compression);
+		static bool is_registered(const codec_types& codec);
+		static unsigned int registered_codecs(void);
+		static codec_types negotiate(const codec_types& requested, const unsigned int& peer_codecs);
+
+	public:
+		static std::vector<unsigned char> compression(const std::vector<unsigned char>& original_data, const codec_types& codec, const int& level = 0);
+		static int level(const codec_types& codec, const int& level);
+		static std::wstring name(const codec_types& codec);
+		static bool parse(const std::wstring& source, codec_types& codec, int& level);
+
+	private:
+		struct codec_entry
+		{
+			std::wstring name;
+			int minimum_level;
+			int maximum_level;
+			int default_level;
+			std::function<std::vector<unsigned char>(const std::vector<unsigned char>&, const int&)> compression;
+		};
+
+	private:
+		static std::map<codec_types, codec_entry>& codecs(void);
+
+	private:
+		static std::mutex _mutex;
+	};
+}
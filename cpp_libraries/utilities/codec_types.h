@@ -0,0 +1,12 @@
+#pragma once
+
+namespace compressing
+{
+	enum class codec_types : unsigned short
+	{
+		none = 0,
+		lz4 = 1,
+		lz4hc = 2,
+		zstd = 3
+	};
+}
\ No newline at end of file
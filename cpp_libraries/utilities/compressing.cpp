@@ -1,78 +1,304 @@
 ﻿#include "compressing.h"
 
 #include "logging.h"
+#include "converting.h"
 
 #include "lz4.h"
+#include "lz4hc.h"
+#include "zstd.h"
+#include "zdict.h"
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
 
 #include "fmt/format.h"
 
 namespace compressing
 {
 	using namespace logging;
+	using namespace converting;
 
-	unsigned short compressor::_block_bytes = 1024;
-
-	std::vector<unsigned char> compressor::compression(const std::vector<unsigned char>& original_data)
+	namespace
 	{
-		if (original_data.empty())
+		// marker, frame bytes, original size and block count
+		const int frame_marker = -1;
+		const int zstd_marker = -2;
+		const size_t frame_header_bytes = sizeof(int) + sizeof(unsigned int) + sizeof(unsigned long long) + sizeof(unsigned int);
+
+		// an LZ4 block cannot expand its input by more than this, so a larger claimed size is a broken or hostile header
+		const unsigned long long maximum_lz4_ratio = 255;
+
+		// each thread keeps one stream and only fast resets it per block, instead of allocating and clearing a new state
+		LZ4_stream_t* frame_stream(void)
 		{
-			return original_data;
+			thread_local bool initialized = false;
+			thread_local LZ4_stream_t stream;
+			if (!initialized)
+			{
+				LZ4_initStream(&stream, sizeof(stream));
+				initialized = true;
+
+				return &stream;
+			}
+
+			LZ4_resetStream_fast(&stream);
+
+			return &stream;
 		}
 
-		auto start = logger::handle().chrono_start();
+		// the high compression state is large, so it is only allocated by the threads that use it
+		LZ4_streamHC_t* frame_hc_stream(const int& level)
+		{
+			thread_local std::unique_ptr<LZ4_streamHC_t, decltype(&LZ4_freeStreamHC)> stream(nullptr, &LZ4_freeStreamHC);
+			if (stream == nullptr)
+			{
+				stream.reset(LZ4_createStreamHC());
+			}
 
-		LZ4_stream_t lz4Stream_body;
-		size_t read_index = 0;
-		int source_buffer_index = 0;
+			LZ4_resetStreamHC_fast(stream.get(), level);
 
-		std::vector<std::vector<char>> source_buffer;
-		source_buffer.push_back(std::vector<char>());
-		source_buffer.push_back(std::vector<char>());
-		source_buffer[0].reserve(_block_bytes);
-		source_buffer[1].reserve(_block_bytes);
+			return stream.get();
+		}
 
-		int compress_size = LZ4_COMPRESSBOUND(_block_bytes);
-		std::vector<char> compress_buffer;
-		compress_buffer.reserve(compress_size);
-		std::vector<unsigned char> compressed_data;
+		ZSTD_CCtx* zstd_compression_context(void)
+		{
+			thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(ZSTD_createCCtx(), &ZSTD_freeCCtx);
 
-		char compress_size_data[4];
+			return context.get();
+		}
 
-		LZ4_resetStream(&lz4Stream_body);
+		ZSTD_DCtx* zstd_decompression_context(void)
+		{
+			thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(ZSTD_createDCtx(), &ZSTD_freeDCtx);
 
-		while (true) {
-			char* const source_buffer_pointer = source_buffer[source_buffer_index].data();
-			memset(source_buffer_pointer, 0, sizeof(char) * _block_bytes);
+			return context.get();
+		}
 
-			const size_t inpBytes = ((original_data.size() - read_index) > _block_bytes) ? _block_bytes : (original_data.size() - read_index);
-			if (0 == inpBytes) {
-				break;
+		// the blocks of one call; a helper only touches the task while the caller is still waiting for it
+		struct frame_batch
+		{
+			size_t block_count;
+			const std::function<bool(const size_t&)>* task;
+			std::atomic<size_t> next;
+			std::atomic<bool> failed;
+			std::mutex mutex;
+			std::condition_variable finished;
+			size_t running;
+			bool closed;
+
+			void work(void)
+			{
+				while (!failed)
+				{
+					size_t index = next.fetch_add(1);
+					if (index >= block_count)
+					{
+						break;
+					}
+
+					if (!(*task)(index))
+					{
+						failed = true;
+					}
+				}
 			}
+		};
 
-			memcpy(source_buffer_pointer, original_data.data() + read_index, sizeof(char) * inpBytes);
+		// helper threads are started once and kept, so a frame does not pay for creating and joining threads
+		class frame_helpers
+		{
+		public:
+			~frame_helpers(void)
+			{
+				std::unique_lock<std::mutex> unique(_mutex);
+				_stopped = true;
+				unique.unlock();
+
+				_condition.notify_all();
+				for (auto& thread : _threads)
+				{
+					thread.join();
+				}
+			}
 
+			static frame_helpers& handle(void)
 			{
-				char* const compress_buffer_pointer = compress_buffer.data();
-				memset(compress_buffer_pointer, 0, sizeof(char) * compress_size);
+				static frame_helpers helpers;
 
-				const int compressed_size = LZ4_compress_fast_continue(&lz4Stream_body, (const char*)source_buffer_pointer, (char*)compress_buffer_pointer, (int)inpBytes, compress_size, 1);
-				if (compressed_size <= 0) {
-					break;
+				return helpers;
+			}
+
+			void request(std::shared_ptr<frame_batch> batch, const size_t& helper_count)
+			{
+				std::unique_lock<std::mutex> unique(_mutex);
+				while (_threads.size() < helper_count)
+				{
+					_threads.push_back(std::thread(&frame_helpers::run, this));
+				}
+
+				for (size_t index = 0; index < helper_count; ++index)
+				{
+					_batches.push_back(batch);
+				}
+				unique.unlock();
+
+				_condition.notify_all();
+			}
+
+		protected:
+			void run(void)
+			{
+				while (true)
+				{
+					std::unique_lock<std::mutex> unique(_mutex);
+					_condition.wait(unique, [this]() { return _stopped || !_batches.empty(); });
+					if (_stopped)
+					{
+						return;
+					}
+
+					std::shared_ptr<frame_batch> batch = _batches.front();
+					_batches.pop_front();
+					unique.unlock();
+
+					std::unique_lock<std::mutex> batch_unique(batch->mutex);
+					if (batch->closed)
+					{
+						continue;
+					}
+					++batch->running;
+					batch_unique.unlock();
+
+					batch->work();
+
+					batch_unique.lock();
+					--batch->running;
+					batch_unique.unlock();
+
+					batch->finished.notify_one();
 				}
+			}
 
-				memcpy(compress_size_data, &compressed_size, sizeof(int));
+		private:
+			bool _stopped = false;
+			std::mutex _mutex;
+			std::condition_variable _condition;
+			std::deque<std::shared_ptr<frame_batch>> _batches;
+			std::vector<std::thread> _threads;
+		};
 
-				compressed_data.insert(compressed_data.end(), compress_size_data, compress_size_data + sizeof(int));
-				compressed_data.insert(compressed_data.end(), compress_buffer_pointer, compress_buffer_pointer + compressed_size);
+		// the calling thread works on the blocks together with the helpers, which pick the next index until none is left
+		bool run_blocks(const size_t& block_count, const unsigned short& frame_threads, const std::function<bool(const size_t&)>& task)
+		{
+			std::shared_ptr<frame_batch> batch = std::make_shared<frame_batch>();
+			batch->block_count = block_count;
+			batch->task = &task;
+			batch->next = 0;
+			batch->failed = false;
+			batch->running = 0;
+			batch->closed = false;
+
+			size_t thread_count = (frame_threads > 0) ? frame_threads : std::thread::hardware_concurrency();
+			thread_count = (std::max)((std::min)(thread_count, block_count), (size_t)1);
+			if (thread_count > 1)
+			{
+				frame_helpers::handle().request(batch, thread_count - 1);
+			}
+
+			batch->work();
+
+			// helpers that pick the batch up from now on leave it alone, the ones already inside are waited for
+			std::unique_lock<std::mutex> unique(batch->mutex);
+			batch->closed = true;
+			batch->finished.wait(unique, [&batch]() { return batch->running == 0; });
+
+			return !batch->failed;
+		}
+	}
+
+	unsigned short compressor::_block_bytes = 1024;
+	unsigned int compressor::_frame_bytes = 262144;
+	size_t compressor::_frame_threshold = 1048576;
+	unsigned short compressor::_frame_threads = 0;
+	size_t compressor::_decompressed_limit = 1073741824;
+
+	std::vector<unsigned char> compressor::compression(const std::vector<unsigned char>& original_data)
+	{
+		return compression(original_data, std::vector<unsigned char>());
+	}
+
+	std::vector<unsigned char> compressor::compression(const std::vector<unsigned char>& original_data, const std::vector<unsigned char>& dictionary)
+	{
+		if (original_data.empty())
+		{
+			return original_data;
+		}
+
+		if (dictionary.empty() && original_data.size() >= _frame_threshold)
+		{
+			return framed_compression(original_data);
+		}
+
+		return block_compression(original_data, dictionary, 0);
+	}
+
+	std::vector<unsigned char> compressor::block_compression(const std::vector<unsigned char>& original_data, const std::vector<unsigned char>& dictionary, const int& level)
+	{
+		auto start = logger::handle().chrono_start();
+
+		// a positive level selects LZ4-HC, whose blocks decode with the same LZ4 decoder
+		LZ4_stream_t lz4Stream_body;
+		LZ4_streamHC_t* lz4StreamHC_body = nullptr;
+		if (level > 0)
+		{
+			lz4StreamHC_body = frame_hc_stream(level);
+			if (!dictionary.empty())
+			{
+				LZ4_loadDictHC(lz4StreamHC_body, (const char*)dictionary.data(), (int)dictionary.size());
+			}
+		}
+		else
+		{
+			LZ4_resetStream(&lz4Stream_body);
+			if (!dictionary.empty())
+			{
+				LZ4_loadDict(&lz4Stream_body, (const char*)dictionary.data(), (int)dictionary.size());
+			}
+		}
+
+		// the source stays in place for the whole call, so the blocks are compressed straight out of it
+		// and into one output sized for the worst case
+		int compress_size = LZ4_COMPRESSBOUND(_block_bytes);
+		size_t block_count = (original_data.size() + _block_bytes - 1) / _block_bytes;
+		std::vector<unsigned char> compressed_data(block_count * (sizeof(int) + compress_size));
+
+		size_t read_index = 0;
+		size_t write_index = 0;
+		while (read_index < original_data.size())
+		{
+			const int inpBytes = (int)(std::min)(original_data.size() - read_index, (size_t)_block_bytes);
+			const char* source = (const char*)original_data.data() + read_index;
+			char* target = (char*)compressed_data.data() + write_index + sizeof(int);
+			const int compressed_size = (lz4StreamHC_body != nullptr) ? LZ4_compress_HC_continue(lz4StreamHC_body, source, target, inpBytes, compress_size)
+				: LZ4_compress_fast_continue(&lz4Stream_body, source, target, inpBytes, compress_size, 1);
+			if (compressed_size <= 0)
+			{
+				break;
 			}
 
+			memcpy(compressed_data.data() + write_index, &compressed_size, sizeof(int));
+
+			write_index += sizeof(int) + compressed_size;
 			read_index += inpBytes;
-			source_buffer_index = (source_buffer_index + 1) % 2;
 		}
 
-		source_buffer[0].clear();
-		source_buffer[1].clear();
-		source_buffer.clear();
+		compressed_data.resize(write_index);
 		
 		if (compressed_data.size() == 0)
 		{
@@ -88,86 +314,493 @@ namespace compressing
 	}
 
 	std::vector<unsigned char> compressor::decompression(const std::vector<unsigned char>& compressed_data)
+	{
+		return decompression(compressed_data, std::vector<unsigned char>());
+	}
+
+	std::vector<unsigned char> compressor::decompression(const std::vector<unsigned char>& compressed_data, const std::vector<unsigned char>& dictionary)
 	{
 		if (compressed_data.empty())
 		{
 			return compressed_data;
 		}
 
+		if (is_stored(compressed_data))
+		{
+			return std::vector<unsigned char>(compressed_data.begin() + sizeof(int), compressed_data.end());
+		}
+
+		if (is_framed(compressed_data))
+		{
+			return framed_decompression(compressed_data);
+		}
+
+		if (is_zstd(compressed_data))
+		{
+			return zstd_decompression(compressed_data);
+		}
+
 		auto start = std::chrono::steady_clock::now();
 
+		// every block holds at most _block_bytes, so counting the blocks first sizes the output once
+		// and each block decodes in place behind the previous one it refers to
+		size_t block_count = 0;
+		size_t read_index = 0;
+		int compressed_size = 0;
+		while (compressed_data.size() - read_index >= sizeof(int))
+		{
+			memcpy(&compressed_size, compressed_data.data() + read_index, sizeof(int));
+			if (0 >= compressed_size || LZ4_COMPRESSBOUND(compressor::_block_bytes) < compressed_size
+				|| compressed_data.size() - read_index - sizeof(int) < (size_t)compressed_size)
+			{
+				break;
+			}
+
+			read_index += sizeof(int) + compressed_size;
+			++block_count;
+		}
+
 		LZ4_streamDecode_t lz4StreamDecode_body;
+		if (dictionary.empty())
+		{
+			LZ4_setStreamDecode(&lz4StreamDecode_body, NULL, 0);
+		}
+		else
+		{
+			LZ4_setStreamDecode(&lz4StreamDecode_body, (const char*)dictionary.data(), (int)dictionary.size());
+		}
 
-		int read_index = 0;
-		int compressed_size = 0;
+		std::vector<unsigned char> decompressed_data(block_count * _block_bytes);
 
-		int target_buffer_index = 0;
+		read_index = 0;
+		size_t write_index = 0;
+		for (size_t index = 0; index < block_count; ++index)
+		{
+			memcpy(&compressed_size, compressed_data.data() + read_index, sizeof(int));
+			read_index += sizeof(int);
 
-		std::vector<std::vector<char>> target_buffer;
-		target_buffer.push_back(std::vector<char>());
-		target_buffer.push_back(std::vector<char>());
-		target_buffer[0].reserve(_block_bytes);
-		target_buffer[1].reserve(_block_bytes);
+			const int decompressed_size = LZ4_decompress_safe_continue(&lz4StreamDecode_body, (const char*)compressed_data.data() + read_index,
+				(char*)decompressed_data.data() + write_index, compressed_size, _block_bytes);
+			if (decompressed_size <= 0)
+			{
+				break;
+			}
 
-		int compress_size = LZ4_COMPRESSBOUND(_block_bytes);
-		std::vector<char> compress_buffer;
-		compress_buffer.reserve(compress_size);
-		std::vector<unsigned char> decompressed_data;
+			read_index += compressed_size;
+			write_index += decompressed_size;
+		}
 
-		LZ4_setStreamDecode(&lz4StreamDecode_body, NULL, 0);
+		decompressed_data.resize(write_index);
+		
+		if (decompressed_data.size() == 0)
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot complete to decompress data");
 
-		while (true) {
-			char* const compress_buffer_pointer = compress_buffer.data();
+			return std::vector<unsigned char>();
+		}
+		
+		logger::handle().write(logging::logging_level::sequence, fmt::format(L"decompressing(buffer {}): ({} -> {} : {:.2f} %)",
+			_block_bytes, compressed_data.size(), decompressed_data.size(), (((double)compressed_data.size() / (double)decompressed_data.size()) * 100)), start);
+
+		return decompressed_data;
+	}
+
+	std::vector<unsigned char> compressor::store(const std::vector<unsigned char>& original_data)
+	{
+		// a zero block size marks a payload the sender left uncompressed
+		std::vector<unsigned char> result(sizeof(int) + original_data.size(), 0);
+		if (!original_data.empty())
+		{
+			memcpy(result.data() + sizeof(int), original_data.data(), original_data.size());
+		}
+
+		return result;
+	}
+
+	bool compressor::is_stored(const std::vector<unsigned char>& compressed_data)
+	{
+		if (compressed_data.size() < sizeof(int))
+		{
+			return false;
+		}
+
+		int block_size = 0;
+		memcpy(&block_size, compressed_data.data(), sizeof(int));
+
+		return block_size == 0;
+	}
+
+	std::vector<unsigned char> compressor::framed_compression(const std::vector<unsigned char>& original_data, const int& level)
+	{
+		if (original_data.empty())
+		{
+			return original_data;
+		}
+
+		auto start = logger::handle().chrono_start();
+
+		const size_t frame_bytes = _frame_bytes;
+		const size_t block_count = (original_data.size() + frame_bytes - 1) / frame_bytes;
+		const int bound = LZ4_COMPRESSBOUND((int)frame_bytes);
+		const size_t header_size = frame_header_bytes + block_count * sizeof(int);
 
-			memset(compress_buffer_pointer, 0, sizeof(char) * compress_size);
+		// every block owns a worst case slot behind the size table, so the workers never share any output
+		std::vector<unsigned char> compressed_data(header_size + block_count * bound);
+		unsigned char* table = compressed_data.data() + frame_header_bytes;
+		unsigned char* slots = compressed_data.data() + header_size;
 
+		bool completed = run_blocks(block_count, _frame_threads, [&](const size_t& index)
 			{
-				if ((compressed_data.size() - read_index) < 1) {
-					break;
+				const char* source = (const char*)original_data.data() + index * frame_bytes;
+				const int source_size = (int)(std::min)(frame_bytes, original_data.size() - index * frame_bytes);
+				char* target = (char*)slots + index * bound;
+
+				int block_size = (level > 0) ? LZ4_compress_HC_continue(frame_hc_stream(level), source, target, source_size, bound)
+					: LZ4_compress_fast_continue(frame_stream(), source, target, source_size, bound, 1);
+				if (block_size <= 0)
+				{
+					return false;
 				}
 
-				memcpy(&compressed_size, compressed_data.data() + read_index, sizeof(int));
-				if (0 >= compressed_size || compressor::_block_bytes < compressed_size) {
-					break;
+				// a block that does not shrink is kept as it is and marked with a negative size
+				if (block_size >= source_size)
+				{
+					memcpy(target, source, source_size);
+					block_size = -source_size;
 				}
 
-				read_index += sizeof(int);
+				memcpy(table + index * sizeof(int), &block_size, sizeof(int));
+
+				return true;
+			});
+		if (!completed)
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot complete to compress data");
+
+			return std::vector<unsigned char>();
+		}
+
+		size_t write_index = header_size;
+		for (size_t index = 0; index < block_count; ++index)
+		{
+			int block_size = 0;
+			memcpy(&block_size, table + index * sizeof(int), sizeof(int));
+			block_size = std::abs(block_size);
+
+			unsigned char* slot = slots + index * bound;
+			if (slot != compressed_data.data() + write_index)
+			{
+				memmove(compressed_data.data() + write_index, slot, block_size);
+			}
+
+			write_index += block_size;
+		}
+		compressed_data.resize(write_index);
+
+		int marker = frame_marker;
+		unsigned int frame_size = (unsigned int)frame_bytes;
+		unsigned long long original_size = original_data.size();
+		unsigned int count = (unsigned int)block_count;
+		memcpy(compressed_data.data(), &marker, sizeof(int));
+		memcpy(compressed_data.data() + sizeof(int), &frame_size, sizeof(unsigned int));
+		memcpy(compressed_data.data() + sizeof(int) + sizeof(unsigned int), &original_size, sizeof(unsigned long long));
+		memcpy(compressed_data.data() + sizeof(int) + sizeof(unsigned int) + sizeof(unsigned long long), &count, sizeof(unsigned int));
+
+		logger::handle().write(logging::logging_level::sequence, fmt::format(L"compressing(frame {} x {}): ({} -> {} : {:.2f} %)",
+			frame_bytes, block_count, original_data.size(), compressed_data.size(), (((double)compressed_data.size() / (double)original_data.size()) * 100)), start);
 
-				memcpy(compress_buffer_pointer, compressed_data.data() + read_index, sizeof(char) * compressed_size);
+		return compressed_data;
+	}
+
+	std::vector<unsigned char> compressor::framed_decompression(const std::vector<unsigned char>& compressed_data)
+	{
+		if (!is_framed(compressed_data) || compressed_data.size() < frame_header_bytes)
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot decompress frame: broken header");
+
+			return std::vector<unsigned char>();
+		}
+
+		auto start = logger::handle().chrono_start();
+
+		unsigned int frame_size = 0;
+		unsigned long long original_size = 0;
+		unsigned int count = 0;
+		memcpy(&frame_size, compressed_data.data() + sizeof(int), sizeof(unsigned int));
+		memcpy(&original_size, compressed_data.data() + sizeof(int) + sizeof(unsigned int), sizeof(unsigned long long));
+		memcpy(&count, compressed_data.data() + sizeof(int) + sizeof(unsigned int) + sizeof(unsigned long long), sizeof(unsigned int));
+
+		// the output is allocated from the header, so its size is held to what the payload can actually expand to
+		const size_t frame_bytes = frame_size;
+		const size_t block_count = count;
+		const unsigned long long expandable = (compressed_data.size() - frame_header_bytes) * maximum_lz4_ratio;
+		if (original_size > _decompressed_limit || original_size > expandable)
+		{
+			logger::handle().write(logging::logging_level::error, fmt::format(L"cannot decompress frame: {} bytes exceeds the limit", original_size));
+
+			return std::vector<unsigned char>();
+		}
+
+		if (frame_bytes == 0 || frame_bytes > LZ4_MAX_INPUT_SIZE || frame_bytes > _decompressed_limit || block_count == 0
+			|| block_count != (original_size + frame_bytes - 1) / frame_bytes
+			|| (compressed_data.size() - frame_header_bytes) / sizeof(int) < block_count)
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot decompress frame: broken header");
 
-				read_index += compressed_size;
+			return std::vector<unsigned char>();
+		}
+
+		// the offsets are kept per thread, so decoding the same sized frames again does not allocate them
+		thread_local std::vector<size_t> frame_offsets;
+		std::vector<size_t>& offsets = frame_offsets;
+		offsets.resize(block_count);
+
+		const int bound = LZ4_COMPRESSBOUND((int)frame_bytes);
+		const unsigned char* table = compressed_data.data() + frame_header_bytes;
+		size_t read_index = frame_header_bytes + block_count * sizeof(int);
+		for (size_t index = 0; index < block_count; ++index)
+		{
+			int block_size = 0;
+			memcpy(&block_size, table + index * sizeof(int), sizeof(int));
+
+			// a stored block carries its negated length, so the range is checked before the size is negated
+			const size_t block_length = (std::min)(frame_bytes, (size_t)(original_size - index * frame_bytes));
+			if (block_size == 0 || block_size > bound || block_size < -(int)frame_bytes)
+			{
+				logger::handle().write(logging::logging_level::error, fmt::format(L"cannot decompress frame: broken block {}", index));
+
+				return std::vector<unsigned char>();
 			}
 
+			const size_t block_bytes = (size_t)(block_size < 0 ? -block_size : block_size);
+			if ((block_size < 0 && block_bytes != block_length) || compressed_data.size() - read_index < block_bytes)
 			{
-				char* const target_buffer_pointer = target_buffer[target_buffer_index].data();
-				const int decompressed_size = LZ4_decompress_safe_continue(&lz4StreamDecode_body, (const char*)compress_buffer_pointer, (char*)target_buffer_pointer, compressed_size, _block_bytes);
-				if (decompressed_size <= 0) {
-					break;
-				}
+				logger::handle().write(logging::logging_level::error, fmt::format(L"cannot decompress frame: broken block {}", index));
 
-				decompressed_data.insert(decompressed_data.end(), target_buffer_pointer, target_buffer_pointer + decompressed_size);
+				return std::vector<unsigned char>();
 			}
 
-			target_buffer_index = (target_buffer_index + 1) % 2;
+			offsets[index] = read_index;
+			read_index += block_bytes;
 		}
 
-		target_buffer[0].clear();
-		target_buffer[1].clear();
-		target_buffer.clear();
-		
-		if (decompressed_data.size() == 0)
+		// the blocks are written back to back, so together they must fill the payload exactly
+		if (read_index != compressed_data.size())
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot decompress frame: blocks do not match the payload");
+
+			return std::vector<unsigned char>();
+		}
+
+		std::vector<unsigned char> decompressed_data(original_size);
+
+		bool completed = run_blocks(block_count, _frame_threads, [&](const size_t& index)
+			{
+				int block_size = 0;
+				memcpy(&block_size, table + index * sizeof(int), sizeof(int));
+
+				const char* source = (const char*)compressed_data.data() + offsets[index];
+				char* target = (char*)decompressed_data.data() + index * frame_bytes;
+				const int block_length = (int)(std::min)(frame_bytes, decompressed_data.size() - index * frame_bytes);
+				if (block_size < 0)
+				{
+					memcpy(target, source, block_length);
+
+					return true;
+				}
+
+				return LZ4_decompress_safe(source, target, block_size, block_length) == block_length;
+			});
+		if (!completed)
 		{
 			logger::handle().write(logging::logging_level::error, L"cannot complete to decompress data");
 
 			return std::vector<unsigned char>();
 		}
-		
-		logger::handle().write(logging::logging_level::sequence, fmt::format(L"decompressing(buffer {}): ({} -> {} : {:.2f} %)",
-			_block_bytes, compressed_data.size(), decompressed_data.size(), (((double)compressed_data.size() / (double)decompressed_data.size()) * 100)), start);
+
+		logger::handle().write(logging::logging_level::sequence, fmt::format(L"decompressing(frame {} x {}): ({} -> {} : {:.2f} %)",
+			frame_bytes, block_count, compressed_data.size(), decompressed_data.size(), (((double)compressed_data.size() / (double)decompressed_data.size()) * 100)), start);
+
+		return decompressed_data;
+	}
+
+	bool compressor::is_framed(const std::vector<unsigned char>& compressed_data)
+	{
+		if (compressed_data.size() < sizeof(int))
+		{
+			return false;
+		}
+
+		int block_size = 0;
+		memcpy(&block_size, compressed_data.data(), sizeof(int));
+
+		return block_size == frame_marker;
+	}
+
+	std::vector<unsigned char> compressor::hc_compression(const std::vector<unsigned char>& original_data, const int& level)
+	{
+		if (original_data.empty())
+		{
+			return original_data;
+		}
+
+		int hc_level = (std::max)(1, (std::min)(level, LZ4HC_CLEVEL_MAX));
+		if (original_data.size() >= _frame_threshold)
+		{
+			return framed_compression(original_data, hc_level);
+		}
+
+		return block_compression(original_data, std::vector<unsigned char>(), hc_level);
+	}
+
+	std::vector<unsigned char> compressor::zstd_compression(const std::vector<unsigned char>& original_data, const int& level)
+	{
+		if (original_data.empty())
+		{
+			return original_data;
+		}
+
+		auto start = logger::handle().chrono_start();
+
+		// a zstd frame carries its own sizes, so only the marker is put in front of it
+		std::vector<unsigned char> compressed_data(sizeof(int) + ZSTD_compressBound(original_data.size()));
+		size_t compressed_size = ZSTD_compressCCtx(zstd_compression_context(), compressed_data.data() + sizeof(int), compressed_data.size() - sizeof(int),
+			original_data.data(), original_data.size(), level);
+		if (ZSTD_isError(compressed_size))
+		{
+			logger::handle().write(logging::logging_level::error, fmt::format(L"cannot complete to compress data: {}", converter::to_wstring(ZSTD_getErrorName(compressed_size))));
+
+			return std::vector<unsigned char>();
+		}
+
+		int marker = zstd_marker;
+		memcpy(compressed_data.data(), &marker, sizeof(int));
+		compressed_data.resize(sizeof(int) + compressed_size);
+
+		logger::handle().write(logging::logging_level::sequence, fmt::format(L"compressing(zstd {}): ({} -> {} : {:.2f} %)",
+			level, original_data.size(), compressed_data.size(), (((double)compressed_data.size() / (double)original_data.size()) * 100)), start);
+
+		return compressed_data;
+	}
+
+	std::vector<unsigned char> compressor::zstd_decompression(const std::vector<unsigned char>& compressed_data)
+	{
+		if (!is_zstd(compressed_data))
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot decompress zstd: broken header");
+
+			return std::vector<unsigned char>();
+		}
+
+		auto start = logger::handle().chrono_start();
+
+		unsigned long long original_size = ZSTD_getFrameContentSize(compressed_data.data() + sizeof(int), compressed_data.size() - sizeof(int));
+		if (original_size == ZSTD_CONTENTSIZE_ERROR || original_size == ZSTD_CONTENTSIZE_UNKNOWN)
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot decompress zstd: broken header");
+
+			return std::vector<unsigned char>();
+		}
+
+		// the content size comes from the sender, so it is checked before the output is allocated
+		if (original_size > _decompressed_limit)
+		{
+			logger::handle().write(logging::logging_level::error, fmt::format(L"cannot decompress zstd: {} bytes exceeds the limit", original_size));
+
+			return std::vector<unsigned char>();
+		}
+
+		std::vector<unsigned char> decompressed_data(original_size);
+		size_t decompressed_size = ZSTD_decompressDCtx(zstd_decompression_context(), decompressed_data.data(), decompressed_data.size(),
+			compressed_data.data() + sizeof(int), compressed_data.size() - sizeof(int));
+		if (ZSTD_isError(decompressed_size) || decompressed_size != original_size)
+		{
+			logger::handle().write(logging::logging_level::error, L"cannot complete to decompress data");
+
+			return std::vector<unsigned char>();
+		}
+
+		logger::handle().write(logging::logging_level::sequence, fmt::format(L"decompressing(zstd): ({} -> {} : {:.2f} %)",
+			compressed_data.size(), decompressed_data.size(), (((double)compressed_data.size() / (double)decompressed_data.size()) * 100)), start);
 
 		return decompressed_data;
 	}
 
+	bool compressor::is_zstd(const std::vector<unsigned char>& compressed_data)
+	{
+		if (compressed_data.size() < sizeof(int))
+		{
+			return false;
+		}
+
+		int block_size = 0;
+		memcpy(&block_size, compressed_data.data(), sizeof(int));
+
+		return block_size == zstd_marker;
+	}
+
+	std::vector<unsigned char> compressor::train_dictionary(const std::vector<std::vector<unsigned char>>& samples, const size_t& dictionary_size)
+	{
+		// an LZ4 dictionary is plain history and only its last 64 KB are used
+		size_t limit = (std::min)(dictionary_size, (size_t)(64 * 1024));
+
+		std::vector<unsigned char> buffer;
+		std::vector<size_t> sizes;
+		for (auto& sample : samples)
+		{
+			if (!sample.empty())
+			{
+				buffer.insert(buffer.end(), sample.begin(), sample.end());
+				sizes.push_back(sample.size());
+			}
+		}
+
+		if (buffer.empty() || limit == 0)
+		{
+			return std::vector<unsigned char>();
+		}
+
+		// zstd keeps the segments that recur across samples and puts the most useful ones last, where LZ4 matches are closest
+		std::vector<unsigned char> trained(limit);
+		size_t trained_size = ZDICT_trainFromBuffer(trained.data(), trained.size(), buffer.data(), sizes.data(), (unsigned int)sizes.size());
+		if (ZDICT_isError(trained_size))
+		{
+			logger::handle().write(logging::logging_level::information,
+				fmt::format(L"cannot train dictionary from {} samples: {}, so the latest samples are used as history", sizes.size(), converter::to_wstring(ZDICT_getErrorName(trained_size))));
+
+			size_t start = buffer.size() - (std::min)(buffer.size(), limit);
+
+			return std::vector<unsigned char>(buffer.begin() + start, buffer.end());
+		}
+
+		// the header carries zstd entropy tables that LZ4 cannot use, so only the content is kept
+		size_t header_size = ZDICT_getDictHeaderSize(trained.data(), trained_size);
+		if (ZDICT_isError(header_size) || header_size > trained_size)
+		{
+			header_size = 0;
+		}
+
+		return std::vector<unsigned char>(trained.begin() + header_size, trained.begin() + trained_size);
+	}
+
+	unsigned int compressor::dictionary_id(const std::vector<unsigned char>& dictionary)
+	{
+		if (dictionary.empty())
+		{
+			return 0;
+		}
+
+		// FNV-1a, so both ends can tell in the handshake whether they hold the same dictionary
+		unsigned int result = 2166136261u;
+		for (auto& data : dictionary)
+		{
+			result ^= data;
+			result *= 16777619u;
+		}
+
+		return (result == 0) ? 1 : result;
+	}
+
 	void compressor::set_block_bytes(const unsigned short& block_bytes)
 	{
 		_block_bytes = block_bytes;
@@ -177,4 +810,44 @@ namespace compressing
 	{
 		return _block_bytes;
 	}
+
+	void compressor::set_frame_bytes(const unsigned int& frame_bytes)
+	{
+		if (frame_bytes == 0 || frame_bytes > LZ4_MAX_INPUT_SIZE)
+		{
+			return;
+		}
+
+		_frame_bytes = frame_bytes;
+	}
+
+	unsigned int compressor::get_frame_bytes(void)
+	{
+		return _frame_bytes;
+	}
+
+	void compressor::set_frame_threshold(const size_t& frame_threshold)
+	{
+		_frame_threshold = frame_threshold;
+	}
+
+	void compressor::set_frame_threads(const unsigned short& frame_threads)
+	{
+		_frame_threads = frame_threads;
+	}
+
+	void compressor::set_decompressed_limit(const size_t& decompressed_limit)
+	{
+		_decompressed_limit = decompressed_limit;
+	}
+
+	std::vector<unsigned char> compressor::chained_compression(const std::vector<unsigned char>& original_data)
+	{
+		if (original_data.empty())
+		{
+			return original_data;
+		}
+
+		return block_compression(original_data, std::vector<unsigned char>(), 0);
+	}
 }
\ No newline at end of file
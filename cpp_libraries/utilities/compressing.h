@@ -9,13 +9,47 @@ namespace compressing
 	public:
 		static std::vector<unsigned char> compression(const std::vector<unsigned char>& original_data);
 		static std::vector<unsigned char> decompression(const std::vector<unsigned char>& compressed_data);
+		static std::vector<unsigned char> compression(const std::vector<unsigned char>& original_data, const std::vector<unsigned char>& dictionary);
+		static std::vector<unsigned char> decompression(const std::vector<unsigned char>& compressed_data, const std::vector<unsigned char>& dictionary);
+		static std::vector<unsigned char> chained_compression(const std::vector<unsigned char>& original_data);
+
+	public:
+		static std::vector<unsigned char> store(const std::vector<unsigned char>& original_data);
+		static bool is_stored(const std::vector<unsigned char>& compressed_data);
+
+	public:
+		static std::vector<unsigned char> framed_compression(const std::vector<unsigned char>& original_data, const int& level = 0);
+		static std::vector<unsigned char> framed_decompression(const std::vector<unsigned char>& compressed_data);
+		static bool is_framed(const std::vector<unsigned char>& compressed_data);
+
+	public:
+		static std::vector<unsigned char> hc_compression(const std::vector<unsigned char>& original_data, const int& level);
+		static std::vector<unsigned char> zstd_compression(const std::vector<unsigned char>& original_data, const int& level);
+		static std::vector<unsigned char> zstd_decompression(const std::vector<unsigned char>& compressed_data);
+		static bool is_zstd(const std::vector<unsigned char>& compressed_data);
+
+	public:
+		static std::vector<unsigned char> train_dictionary(const std::vector<std::vector<unsigned char>>& samples, const size_t& dictionary_size = 65536);
+		static unsigned int dictionary_id(const std::vector<unsigned char>& dictionary);
 
 	public:
 		static void set_block_bytes(const unsigned short& block_bytes);
 		static unsigned short get_block_bytes(void);
+		static void set_frame_bytes(const unsigned int& frame_bytes);
+		static unsigned int get_frame_bytes(void);
+		static void set_frame_threshold(const size_t& frame_threshold);
+		static void set_frame_threads(const unsigned short& frame_threads);
+		static void set_decompressed_limit(const size_t& decompressed_limit);
+
+	protected:
+		static std::vector<unsigned char> block_compression(const std::vector<unsigned char>& original_data, const std::vector<unsigned char>& dictionary, const int& level);
 
 	private:
 		static unsigned short _block_bytes;
+		static unsigned int _frame_bytes;
+		static size_t _frame_threshold;
+		static unsigned short _frame_threads;
+		static size_t _decompressed_limit;
 	};
 }
 
@@ -3,10 +3,61 @@
 #include <codecvt>
 
 #include "fmt/format.h"
-#include "cryptopp/base64.h"
 
 namespace converting
 {
+	constexpr wchar_t BASE64_ENCODE[] = L"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	constexpr signed char BASE64_DECODE[256] =
+	{
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+		52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+		-1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+		15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+		-1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+		41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+	};
+
+	template <typename T> void encode_base64(const unsigned char* data, const size_t& size, T* target)
+	{
+		size_t index = 0;
+		for (; index + 3 <= size; index += 3)
+		{
+			unsigned long block = ((unsigned long)data[index] << 16) | ((unsigned long)data[index + 1] << 8) | data[index + 2];
+
+			*target++ = (T)BASE64_ENCODE[(block >> 18) & 0x3f];
+			*target++ = (T)BASE64_ENCODE[(block >> 12) & 0x3f];
+			*target++ = (T)BASE64_ENCODE[(block >> 6) & 0x3f];
+			*target++ = (T)BASE64_ENCODE[block & 0x3f];
+		}
+
+		if (index == size)
+		{
+			return;
+		}
+
+		unsigned long block = (unsigned long)data[index] << 16;
+		if (index + 1 < size)
+		{
+			block |= (unsigned long)data[index + 1] << 8;
+		}
+
+		*target++ = (T)BASE64_ENCODE[(block >> 18) & 0x3f];
+		*target++ = (T)BASE64_ENCODE[(block >> 12) & 0x3f];
+		*target++ = (index + 1 < size) ? (T)BASE64_ENCODE[(block >> 6) & 0x3f] : (T)'=';
+		*target++ = (T)'=';
+	}
+
 	void converter::replace(std::wstring& source, const std::wstring& token, const std::wstring& target)
 	{
 		source = replace2(source, token, target);
@@ -108,33 +159,139 @@ namespace converting
 
 	std::wstring converter::to_wstring(const std::vector<unsigned char>& value)
 	{
-		if (value.empty())
+		return to_wstring(value.data(), value.size());
+	}
+
+	std::wstring converter::to_wstring(const unsigned char* value, const size_t& size)
+	{
+		if (value == nullptr || size == 0)
 		{
 			return std::wstring();
 		}
 
 		// UTF-8 BOM
-		if (value.size() >= 3 && value[0] == 0xef && value[1] == 0xbb && value[2] == 0xbf)
+		if (size >= 3 && value[0] == 0xef && value[1] == 0xbb && value[2] == 0xbf)
 		{
-			return to_wstring(std::string((char*)value.data() + 2, value.size() - 2));
+			return to_wstring(std::string((char*)value + 3, size - 3));
 		}
 
 		// UTF-8 no BOM
-		return to_wstring(std::string((char*)value.data(), value.size()));
+		return to_wstring(std::string((char*)value, size));
 	}
 
-	std::vector<unsigned char> converter::from_base64(const std::wstring& value)
+	std::vector<unsigned char> converter::to_array(const std::string& value)
+	{
+		return std::vector<unsigned char>(value.begin(), value.end());
+	}
+
+	std::string converter::to_string(const std::vector<unsigned char>& value)
 	{
 		if (value.empty())
 		{
-			return std::vector<unsigned char>();
+			return std::string();
 		}
 
-		std::string source = to_string(value);
-		std::string encoded;
-		CryptoPP::StringSource(source.data(), true, new CryptoPP::Base64Decoder(new CryptoPP::StringSink(encoded)));
+		// UTF-8 BOM
+		if (value.size() >= 3 && value[0] == 0xef && value[1] == 0xbb && value[2] == 0xbf)
+		{
+			return std::string((char*)value.data() + 3, value.size() - 3);
+		}
 
-		return std::vector<unsigned char>(encoded.data(), encoded.data() + encoded.size());
+		return std::string((char*)value.data(), value.size());
+	}
+
+	size_t converter::utf8_length(const std::wstring& value)
+	{
+		size_t result = 0;
+		for (auto& character : value)
+		{
+			unsigned long code = static_cast<unsigned long>(character);
+			if (code < 0x80)
+			{
+				result += 1;
+			}
+			else if (code < 0x800)
+			{
+				result += 2;
+			}
+			else if (code >= 0xD800 && code < 0xDC00)
+			{
+				// a surrogate pair is one 4 byte sequence; the low half adds nothing
+				result += 4;
+			}
+			else if (code >= 0xDC00 && code < 0xE000)
+			{
+				continue;
+			}
+			else if (code < 0x10000)
+			{
+				result += 3;
+			}
+			else
+			{
+				result += 4;
+			}
+		}
+
+		return result;
+	}
+
+	std::vector<unsigned char> converter::from_base64(const std::wstring& value)
+	{
+		return from_base64(value.data(), value.size());
+	}
+
+	std::vector<unsigned char> converter::from_base64(const wchar_t* data, const size_t& size)
+	{
+		std::vector<unsigned char> result;
+		if (data == nullptr || size == 0)
+		{
+			return result;
+		}
+
+		result.reserve((size / 4) * 3 + 3);
+
+		// characters outside the alphabet, such as line breaks, are skipped and '=' ends the input
+		unsigned long block = 0;
+		unsigned char count = 0;
+		for (size_t index = 0; index < size; ++index)
+		{
+			if (data[index] == L'=')
+			{
+				break;
+			}
+
+			unsigned long character = static_cast<unsigned long>(data[index]);
+			if (character > 0xff || BASE64_DECODE[character] < 0)
+			{
+				continue;
+			}
+
+			block = (block << 6) | BASE64_DECODE[character];
+			if (++count < 4)
+			{
+				continue;
+			}
+
+			result.push_back((unsigned char)(block >> 16));
+			result.push_back((unsigned char)(block >> 8));
+			result.push_back((unsigned char)block);
+
+			block = 0;
+			count = 0;
+		}
+
+		if (count == 2)
+		{
+			result.push_back((unsigned char)(block >> 4));
+		}
+		else if (count == 3)
+		{
+			result.push_back((unsigned char)(block >> 10));
+			result.push_back((unsigned char)(block >> 2));
+		}
+
+		return result;
 	}
 
 	std::wstring converter::to_base64(const std::vector<unsigned char>& value)
@@ -144,10 +301,25 @@ namespace converting
 			return std::wstring();
 		}
 
-		std::string decoded;
-		CryptoPP::StringSource(value.data(), true, new CryptoPP::Base64Encoder(new CryptoPP::StringSink(decoded)));
+		std::wstring result(base64_length(value.size()), L'=');
+		to_base64(value.data(), value.size(), &result[0]);
+
+		return result;
+	}
+
+	size_t converter::base64_length(const size_t& size)
+	{
+		return ((size + 2) / 3) * 4;
+	}
+
+	void converter::to_base64(const unsigned char* data, const size_t& size, wchar_t* target)
+	{
+		encode_base64(data, size, target);
+	}
 
-		return to_wstring(decoded);
+	void converter::to_base64(const unsigned char* data, const size_t& size, unsigned char* target)
+	{
+		encode_base64(data, size, target);
 	}
 
 	std::wstring converter::convert(const std::u16string& value)
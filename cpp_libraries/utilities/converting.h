@@ -19,10 +19,20 @@ namespace converting
 	public:
 		static std::vector<unsigned char> to_array(const std::wstring& value);
 		static std::wstring to_wstring(const std::vector<unsigned char>& value);
+		static std::wstring to_wstring(const unsigned char* value, const size_t& size);
+
+	public:
+		static std::vector<unsigned char> to_array(const std::string& value);
+		static std::string to_string(const std::vector<unsigned char>& value);
+		static size_t utf8_length(const std::wstring& value);
 
 	public:
 		static std::vector<unsigned char> from_base64(const std::wstring& value);
+		static std::vector<unsigned char> from_base64(const wchar_t* data, const size_t& size);
 		static std::wstring to_base64(const std::vector<unsigned char>& value);
+		static size_t base64_length(const size_t& size);
+		static void to_base64(const unsigned char* data, const size_t& size, wchar_t* target);
+		static void to_base64(const unsigned char* data, const size_t& size, unsigned char* target);
 
 	private:
 		static std::wstring convert(const std::u16string& value);
@@ -0,0 +1,126 @@
+#include "file_mapping.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <filesystem>
+#endif
+
+namespace file_handling
+{
+#ifdef _WIN32
+	file_mapping::file_mapping(const std::wstring& path)
+		: _data(nullptr), _size(0), _file(INVALID_HANDLE_VALUE), _mapping(nullptr)
+	{
+		_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (_file == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(_file, &file_size) || file_size.QuadPart == 0)
+		{
+			close();
+			return;
+		}
+
+		_mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (_mapping == nullptr)
+		{
+			close();
+			return;
+		}
+
+		_data = static_cast<const unsigned char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (_data == nullptr)
+		{
+			close();
+			return;
+		}
+
+		_size = static_cast<size_t>(file_size.QuadPart);
+	}
+
+	void file_mapping::close(void)
+	{
+		if (_data != nullptr)
+		{
+			UnmapViewOfFile(_data);
+			_data = nullptr;
+		}
+
+		if (_mapping != nullptr)
+		{
+			CloseHandle(_mapping);
+			_mapping = nullptr;
+		}
+
+		if (_file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(_file);
+			_file = INVALID_HANDLE_VALUE;
+		}
+
+		_size = 0;
+	}
+#else
+	file_mapping::file_mapping(const std::wstring& path)
+		: _data(nullptr), _size(0)
+	{
+		int file = open(std::filesystem::path(path).c_str(), O_RDONLY);
+		if (file < 0)
+		{
+			return;
+		}
+
+		struct stat status;
+		if (fstat(file, &status) == 0 && status.st_size > 0)
+		{
+			void* mapped = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+			if (mapped != MAP_FAILED)
+			{
+				_data = static_cast<const unsigned char*>(mapped);
+				_size = static_cast<size_t>(status.st_size);
+			}
+		}
+
+		::close(file);
+	}
+
+	void file_mapping::close(void)
+	{
+		if (_data != nullptr)
+		{
+			munmap(const_cast<unsigned char*>(_data), _size);
+			_data = nullptr;
+		}
+
+		_size = 0;
+	}
+#endif
+
+	file_mapping::~file_mapping(void)
+	{
+		close();
+	}
+
+	bool file_mapping::is_open(void) const
+	{
+		return _data != nullptr;
+	}
+
+	const unsigned char* file_mapping::data(void) const
+	{
+		return _data;
+	}
+
+	size_t file_mapping::size(void) const
+	{
+		return _size;
+	}
+}
\ No newline at end of file
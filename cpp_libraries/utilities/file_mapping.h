@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+namespace file_handling
+{
+	class file_mapping
+	{
+	public:
+		file_mapping(const std::wstring& path);
+		~file_mapping(void);
+
+	public:
+		file_mapping(const file_mapping&) = delete;
+		file_mapping& operator=(const file_mapping&) = delete;
+
+	public:
+		bool is_open(void) const;
+		const unsigned char* data(void) const;
+		size_t size(void) const;
+
+	protected:
+		void close(void);
+
+	private:
+		const unsigned char* _data;
+		size_t _size;
+
+#ifdef _WIN32
+		void* _file;
+		void* _mapping;
+#endif
+	};
+}
@@ -1,5 +1,6 @@
 #include "logging.h"
 
+#include "converting.h"
 #include "file_handling.h"
 
 #include "fmt/chrono.h"
@@ -15,6 +16,7 @@
 
 namespace logging
 {
+	using namespace converting;
 	using namespace file_handling;
 
 	logger::logger(void) : _target_level(logging_level::information), _store_log_root_path(L""), _store_log_file_name(L""), _store_log_extention(L"")
@@ -106,6 +108,16 @@ namespace logging
 		_condition.notify_one();
 	}
 
+	void logger::write(const logging_level& target_level, const std::string& log_data, const std::optional<std::chrono::time_point<std::chrono::high_resolution_clock>>& time)
+	{
+		if (target_level > _target_level)
+		{
+			return;
+		}
+
+		write(target_level, converter::to_wstring(log_data), time);
+	}
+
 	void logger::run(void)
 	{
 		std::vector<std::tuple<logging_level, std::chrono::system_clock::time_point, std::wstring>> buffers;
@@ -38,6 +38,7 @@ namespace logging
 	public:
 		std::chrono::time_point<std::chrono::high_resolution_clock> chrono_start(void);
 		void write(const logging_level& target_level, const std::wstring& log_data, const std::optional<std::chrono::time_point<std::chrono::high_resolution_clock>>& time = std::nullopt);
+		void write(const logging_level& target_level, const std::string& log_data, const std::optional<std::chrono::time_point<std::chrono::high_resolution_clock>>& time = std::nullopt);
 
 	protected:
 		void run(void);
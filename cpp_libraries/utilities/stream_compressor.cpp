@@ -0,0 +1,94 @@
+#include "stream_compressor.h"
+
+#include "compressing.h"
+#include "logging.h"
+
+#include "lz4.h"
+
+#include <algorithm>
+
+namespace compressing
+{
+	using namespace logging;
+
+	stream_compressor::stream_compressor(const std::vector<unsigned char>& dictionary)
+		: _started(false), _offset(0), _dictionary_id(compressor::dictionary_id(dictionary)), _stream(LZ4_createStream()), _ring_buffer(stream_ring_bytes)
+	{
+		if (dictionary.empty())
+		{
+			return;
+		}
+
+		// the dictionary is placed at the head of the ring, so the first blocks are contiguous with it
+		// and it stays usable as history until the ring wraps over it
+		size_t dictionary_size = (std::min)(dictionary.size(), (size_t)stream_history_bytes);
+		memcpy(_ring_buffer.data(), dictionary.data() + dictionary.size() - dictionary_size, dictionary_size);
+		LZ4_loadDict(_stream, _ring_buffer.data(), (int)dictionary_size);
+
+		_offset = dictionary_size;
+	}
+
+	stream_compressor::~stream_compressor(void)
+	{
+		LZ4_freeStream(_stream);
+	}
+
+	unsigned int stream_compressor::dictionary_id(void) const
+	{
+		return _dictionary_id;
+	}
+
+	std::vector<unsigned char> stream_compressor::compression(const std::vector<unsigned char>& original_data)
+	{
+		if (original_data.empty())
+		{
+			return original_data;
+		}
+
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		std::vector<unsigned char> compressed_data;
+		compressed_data.reserve(sizeof(unsigned int) + original_data.size() + original_data.size() / stream_block_bytes * sizeof(int) + 64);
+
+		// the first frame names the dictionary the stream was primed with
+		if (!_started)
+		{
+			const unsigned char* id = reinterpret_cast<const unsigned char*>(&_dictionary_id);
+			compressed_data.insert(compressed_data.end(), id, id + sizeof(unsigned int));
+			_started = true;
+		}
+
+		size_t read_index = 0;
+		while (read_index < original_data.size())
+		{
+			const int block_bytes = (int)(std::min)(original_data.size() - read_index, (size_t)stream_block_bytes);
+			if (_offset + stream_block_bytes > stream_ring_bytes)
+			{
+				_offset = 0;
+			}
+
+			char* const source = _ring_buffer.data() + _offset;
+			memcpy(source, original_data.data() + read_index, block_bytes);
+
+			const int bound = LZ4_COMPRESSBOUND(block_bytes);
+			const size_t position = compressed_data.size();
+			compressed_data.resize(position + sizeof(int) + bound);
+
+			const int compressed_size = LZ4_compress_fast_continue(_stream, source, (char*)compressed_data.data() + position + sizeof(int), block_bytes, bound, 1);
+			if (compressed_size <= 0)
+			{
+				logger::handle().write(logging::logging_level::error, L"cannot complete to compress stream data");
+
+				return std::vector<unsigned char>();
+			}
+
+			memcpy(compressed_data.data() + position, &compressed_size, sizeof(int));
+			compressed_data.resize(position + sizeof(int) + compressed_size);
+
+			_offset += block_bytes;
+			read_index += block_bytes;
+		}
+
+		return compressed_data;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+union LZ4_stream_u;
+
+namespace compressing
+{
+	enum
+	{
+		stream_block_bytes = 8192,
+		stream_history_bytes = 65536,
+		stream_ring_bytes = stream_history_bytes + stream_block_bytes * 2
+	};
+
+	// compresses the messages of one connection as a single LZ4 stream, so each message can match the ones before it;
+	// the peer has to decode every frame in the same order with a stream_decompressor
+	class stream_compressor
+	{
+	public:
+		stream_compressor(const std::vector<unsigned char>& dictionary = std::vector<unsigned char>());
+		~stream_compressor(void);
+
+	public:
+		stream_compressor(const stream_compressor&) = delete;
+		stream_compressor& operator=(const stream_compressor&) = delete;
+
+	public:
+		unsigned int dictionary_id(void) const;
+		std::vector<unsigned char> compression(const std::vector<unsigned char>& original_data);
+
+	private:
+		bool _started;
+		size_t _offset;
+		unsigned int _dictionary_id;
+		std::mutex _mutex;
+		LZ4_stream_u* _stream;
+		std::vector<char> _ring_buffer;
+	};
+}
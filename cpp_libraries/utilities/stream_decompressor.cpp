@@ -0,0 +1,106 @@
+#include "stream_decompressor.h"
+
+#include "compressing.h"
+#include "stream_compressor.h"
+#include "logging.h"
+
+#include "lz4.h"
+
+#include <algorithm>
+
+#include "fmt/format.h"
+
+namespace compressing
+{
+	using namespace logging;
+
+	stream_decompressor::stream_decompressor(const std::vector<unsigned char>& dictionary)
+		: _started(false), _offset(0), _dictionary_id(compressor::dictionary_id(dictionary)), _stream(LZ4_createStreamDecode()), _ring_buffer(stream_ring_bytes)
+	{
+		size_t dictionary_size = (std::min)(dictionary.size(), (size_t)stream_history_bytes);
+		_dictionary.assign(dictionary.end() - dictionary_size, dictionary.end());
+	}
+
+	stream_decompressor::~stream_decompressor(void)
+	{
+		LZ4_freeStreamDecode(_stream);
+	}
+
+	std::vector<unsigned char> stream_decompressor::decompression(const std::vector<unsigned char>& compressed_data)
+	{
+		if (compressed_data.empty())
+		{
+			return compressed_data;
+		}
+
+		std::scoped_lock<std::mutex> guard(_mutex);
+
+		size_t read_index = 0;
+		if (!_started)
+		{
+			unsigned int dictionary_id = 0;
+			if (compressed_data.size() < sizeof(unsigned int))
+			{
+				return std::vector<unsigned char>();
+			}
+
+			memcpy(&dictionary_id, compressed_data.data(), sizeof(unsigned int));
+			read_index += sizeof(unsigned int);
+
+			if (dictionary_id != 0 && dictionary_id != _dictionary_id)
+			{
+				logger::handle().write(logging::logging_level::error, fmt::format(L"cannot decompress stream with unknown dictionary: {}", dictionary_id));
+
+				return std::vector<unsigned char>();
+			}
+
+			if (dictionary_id != 0)
+			{
+				memcpy(_ring_buffer.data(), _dictionary.data(), _dictionary.size());
+				_offset = _dictionary.size();
+			}
+
+			LZ4_setStreamDecode(_stream, _ring_buffer.data(), (int)_offset);
+			_dictionary.clear();
+			_started = true;
+		}
+
+		std::vector<unsigned char> decompressed_data;
+		decompressed_data.reserve(compressed_data.size() * 2);
+
+		while (read_index + sizeof(int) <= compressed_data.size())
+		{
+			int compressed_size = 0;
+			memcpy(&compressed_size, compressed_data.data() + read_index, sizeof(int));
+			read_index += sizeof(int);
+
+			if (compressed_size <= 0 || read_index + compressed_size > compressed_data.size())
+			{
+				logger::handle().write(logging::logging_level::error, L"cannot complete to decompress stream data");
+
+				return std::vector<unsigned char>();
+			}
+
+			if (_offset + stream_block_bytes > stream_ring_bytes)
+			{
+				_offset = 0;
+			}
+
+			char* const target = _ring_buffer.data() + _offset;
+			const int decompressed_size = LZ4_decompress_safe_continue(_stream, (const char*)compressed_data.data() + read_index, target, compressed_size, stream_block_bytes);
+			if (decompressed_size <= 0)
+			{
+				logger::handle().write(logging::logging_level::error, L"cannot complete to decompress stream data");
+
+				return std::vector<unsigned char>();
+			}
+
+			decompressed_data.insert(decompressed_data.end(), target, target + decompressed_size);
+
+			read_index += compressed_size;
+			_offset += decompressed_size;
+		}
+
+		return decompressed_data;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+union LZ4_streamDecode_u;
+
+namespace compressing
+{
+	class stream_decompressor
+	{
+	public:
+		stream_decompressor(const std::vector<unsigned char>& dictionary = std::vector<unsigned char>());
+		~stream_decompressor(void);
+
+	public:
+		stream_decompressor(const stream_decompressor&) = delete;
+		stream_decompressor& operator=(const stream_decompressor&) = delete;
+
+	public:
+		std::vector<unsigned char> decompression(const std::vector<unsigned char>& compressed_data);
+
+	private:
+		bool _started;
+		size_t _offset;
+		unsigned int _dictionary_id;
+		std::mutex _mutex;
+		LZ4_streamDecode_u* _stream;
+		std::vector<unsigned char> _dictionary;
+		std::vector<char> _ring_buffer;
+	};
+}
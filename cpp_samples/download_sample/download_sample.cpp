@@ -3,6 +3,7 @@
 #include "logging.h"
 #include "converting.h"
 #include "messaging_client.h"
+#include "messages.h"
 #include "folder_handling.h"
 #include "argument_parsing.h"
 
@@ -225,30 +226,31 @@ void received_message(std::shared_ptr<container::value_container> container)
 		return;
 	}
 
-	if (container->message_type() == L"transfer_condition")
+	transfer_condition condition;
+	if (container::message_schema<transfer_condition>::from_container(container, condition))
 	{
-		if (container->get_value(L"percentage")->to_ushort() == 0)
+		if (condition.percentage == 0)
 		{
 			logger::handle().write(logging::logging_level::information,
-				fmt::format(L"started download: [{}]", container->get_value(L"indication_id")->to_string()));
+				fmt::format(L"started download: [{}]", condition.indication_id));
 
 			return;
 		}
 
 		logger::handle().write(logging::logging_level::information,
-			fmt::format(L"received percentage: [{}] {}%", container->get_value(L"indication_id")->to_string(), container->get_value(L"percentage")->to_ushort()));
+			fmt::format(L"received percentage: [{}] {}%", condition.indication_id, condition.percentage));
 
-		if (container->get_value(L"completed")->to_boolean())
+		if (condition.completed)
 		{
 			logger::handle().write(logging::logging_level::information,
-				fmt::format(L"completed download: [{}] success-{}, fail-{}", container->get_value(L"indication_id")->to_string(), container->get_value(L"completed_count")->to_ushort(), container->get_value(L"failed_count")->to_ushort()));
+				fmt::format(L"completed download: [{}] success-{}, fail-{}", condition.indication_id, condition.completed_count, condition.failed_count));
 
 			_promise_status.set_value(false);
 		}
-		else if (container->get_value(L"percentage")->to_ushort() == 100)
+		else if (condition.percentage == 100)
 		{
 			logger::handle().write(logging::logging_level::information,
-				fmt::format(L"completed download: [{}]", container->get_value(L"indication_id")->to_string()));
+				fmt::format(L"completed download: [{}]", condition.indication_id));
 
 			_promise_status.set_value(true);
 		}
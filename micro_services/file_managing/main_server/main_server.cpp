@@ -3,6 +3,7 @@
 #include "logging.h"
 #include "messaging_server.h"
 #include "compressing.h"
+#include "codec_registry.h"
 #include "argument_parsing.h"
 
 #include "value.h"
@@ -33,6 +34,8 @@ bool write_console = false;
 bool encrypt_mode = false;
 bool compress_mode = false;
 unsigned short compress_block_size = 1024;
+codec_types compress_codec = codec_types::lz4;
+int compress_codec_level = 0;
 #ifdef _DEBUG
 logging_level log_level = logging_level::parameter;
 #else
@@ -157,6 +160,16 @@ bool parse_arguments(const std::map<std::wstring, std::wstring>& arguments)
 		compress_block_size = (unsigned short)_wtoi(target->second.c_str());
 	}
 
+	target = arguments.find(L"--compress_codec");
+	if (target != arguments.end())
+	{
+		if (!codec_registry::parse(target->second, compress_codec, compress_codec_level))
+		{
+			compress_codec = codec_types::lz4;
+			compress_codec_level = 0;
+		}
+	}
+
 	target = arguments.find(L"--connection_key");
 	if (target != arguments.end())
 	{
@@ -228,6 +241,7 @@ void create_main_server(void)
 	_main_server = std::make_shared<messaging_server>(PROGRAM_NAME);
 	_main_server->set_encrypt_mode(encrypt_mode);
 	_main_server->set_compress_mode(compress_mode);
+	_main_server->set_codec(compress_codec, compress_codec_level);
 	_main_server->set_connection_key(connection_key);
 	_main_server->set_session_limit_count(session_limit_count);
 	_main_server->set_possible_session_types({ session_types::message_line, session_types::file_line });
@@ -285,6 +299,8 @@ void display_help(void)
 	std::wcout << L"\tThe compress_mode on/off. If you want to use compress mode must be appended '--compress_mode true'.\n\tInitialize value is --compress_mode off." << std::endl << std::endl;
 	std::wcout << L"--compress_block_size [value]" << std::endl;
 	std::wcout << L"\tThe compress_mode on/off. If you want to change compress block size must be appended '--compress_block_size size'.\n\tInitialize value is --compress_mode 1024." << std::endl << std::endl;
+	std::wcout << L"--compress_codec [value]" << std::endl;
+	std::wcout << L"\tIf you want to change the codec used while compress mode is on must be appended '--compress_codec [none|lz4|lz4hc|zstd][:level]'.\n\tClients asking for another codec keep theirs. Initialize value is --compress_codec lz4." << std::endl << std::endl;
 	std::wcout << L"--connection_key [value]" << std::endl;
 	std::wcout << L"\tIf you want to change a specific key string for the connection to the main server must be appended\n\t'--connection_key [specific key string]'." << std::endl << std::endl;
 	std::wcout << L"--server_port [value]" << std::endl;
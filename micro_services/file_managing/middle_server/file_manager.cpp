@@ -1,10 +1,6 @@
 #include "file_manager.h"
 
-#include "value.h"
-#include "values/bool_value.h"
-#include "values/ushort_value.h"
-#include "values/ullong_value.h"
-#include "values/string_value.h"
+#include "messages.h"
 
 file_manager::file_manager(void)
 {
@@ -80,11 +76,11 @@ std::shared_ptr<container::value_container> file_manager::received(const std::ws
 			_transferred_percentage.erase(percentage);
 		}
 
-		return std::make_shared<container::value_container>(target_id, target_sub_id, L"transfer_condition",
-			std::vector<std::shared_ptr<container::value>> {
-				std::make_shared<container::string_value>(L"indication_id", indication_id),
-				std::make_shared<container::ushort_value>(L"percentage", temp)
-		});
+		network::transfer_condition condition;
+		condition.indication_id = indication_id;
+		condition.percentage = temp;
+
+		return container::message_schema<network::transfer_condition>::to_container(condition, target_id, target_sub_id);
 	}
 	
 	if (source->second.size() == (target->second.size() + fail->second.size()))
@@ -97,14 +93,14 @@ std::shared_ptr<container::value_container> file_manager::received(const std::ws
 		_failed_list.erase(fail);
 		_transferred_percentage.erase(percentage);
 
-		return std::make_shared<container::value_container>(target_id, target_sub_id, L"transfer_condition",
-			std::vector<std::shared_ptr<container::value>> {
-				std::make_shared<container::string_value>(L"indication_id", indication_id),
-				std::make_shared<container::ushort_value>(L"percentage", temp),
-				std::make_shared<container::ullong_value>(L"completed_count", completed),
-				std::make_shared<container::ullong_value>(L"failed_count", failed),
-				std::make_shared<container::bool_value>(L"completed", true)
-		});
+		network::transfer_condition condition;
+		condition.indication_id = indication_id;
+		condition.percentage = temp;
+		condition.completed_count = completed;
+		condition.failed_count = failed;
+		condition.completed = true;
+
+		return container::message_schema<network::transfer_condition>::to_container(condition, target_id, target_sub_id);
 	}
 
 	return nullptr;
@@ -3,13 +3,14 @@
 #include "logging.h"
 #include "messaging_server.h"
 #include "messaging_client.h"
+#include "messages.h"
 #include "compressing.h"
+#include "codec_registry.h"
 #include "file_manager.h"
 #include "argument_parsing.h"
 
 #include "value.h"
 #include "values/bool_value.h"
-#include "values/ushort_value.h"
 #include "values/string_value.h"
 
 #ifdef _CONSOLE
@@ -35,6 +36,8 @@ bool write_console = false;
 bool encrypt_mode = false;
 bool compress_mode = false;
 unsigned short compress_block_size = 1024;
+codec_types compress_codec = codec_types::lz4;
+int compress_codec_level = 0;
 #ifdef _DEBUG
 logging_level log_level = logging_level::parameter;
 #else
@@ -186,6 +189,16 @@ bool parse_arguments(const std::map<std::wstring, std::wstring>& arguments)
 		compress_block_size = (unsigned short)_wtoi(target->second.c_str());
 	}
 
+	target = arguments.find(L"--compress_codec");
+	if (target != arguments.end())
+	{
+		if (!codec_registry::parse(target->second, compress_codec, compress_codec_level))
+		{
+			compress_codec = codec_types::lz4;
+			compress_codec_level = 0;
+		}
+	}
+
 	target = arguments.find(L"--main_connection_key");
 	if (target != arguments.end())
 	{
@@ -292,8 +305,10 @@ void create_data_line(void)
 
 	_data_line = std::make_shared<messaging_client>(L"data_line");
 	_data_line->set_compress_mode(compress_mode);
+	_data_line->set_codec(compress_codec, compress_codec_level);
 	_data_line->set_connection_key(main_connection_key);
 	_data_line->set_session_types(session_types::message_line);
+	_data_line->set_auto_reconnect(true);
 	_data_line->set_connection_notification(&connection_from_data_line);
 	_data_line->set_message_notification(&received_message_from_data_line);
 	_data_line->start(main_server_ip, main_server_port, high_priority_count, normal_priority_count, low_priority_count);
@@ -308,8 +323,10 @@ void create_file_line(void)
 
 	_file_line = std::make_shared<messaging_client>(L"file_line");
 	_file_line->set_compress_mode(compress_mode);
+	_file_line->set_codec(compress_codec, compress_codec_level);
 	_file_line->set_connection_key(main_connection_key);
 	_file_line->set_session_types(session_types::file_line);
+	_file_line->set_auto_reconnect(true);
 	_file_line->set_connection_notification(&connection_from_file_line);
 	_file_line->set_message_notification(&received_message_from_file_line);
 	_file_line->set_file_notification(&received_file_from_file_line);
@@ -384,20 +401,6 @@ void connection_from_data_line(const std::wstring& target_id, const std::wstring
 
 	logger::handle().write(logging::logging_level::sequence,
 		fmt::format(L"{} on middle server is {} from target: {}[{}]", _data_line->source_id(), condition ? L"connected" : L"disconnected", target_id, target_sub_id));
-
-	if (condition)
-	{
-		return;
-	}
-
-	if (_middle_server == nullptr)
-	{
-		return;
-	}
-
-	std::this_thread::sleep_for(std::chrono::seconds(1));
-
-	_data_line->start(main_server_ip, main_server_port, high_priority_count, normal_priority_count, low_priority_count);
 }
 
 void received_message_from_data_line(std::shared_ptr<container::value_container> container)
@@ -422,20 +425,6 @@ void connection_from_file_line(const std::wstring& target_id, const std::wstring
 
 	logger::handle().write(logging::logging_level::sequence,
 		fmt::format(L"{} on middle server is {} from target: {}[{}]", _file_line->source_id(), condition ? L"connected" : L"disconnected", target_id, target_sub_id));
-
-	if (condition)
-	{
-		return;
-	}
-
-	if (_middle_server == nullptr)
-	{
-		return;
-	}
-
-	std::this_thread::sleep_for(std::chrono::seconds(1));
-
-	_file_line->start(main_server_ip, main_server_port, high_priority_count, normal_priority_count, low_priority_count);
 }
 
 void received_message_from_file_line(std::shared_ptr<container::value_container> container)
@@ -480,22 +469,23 @@ bool download_files(std::shared_ptr<container::value_container> container)
 		return false;
 	}
 
+	std::wstring indication_id = container->get_value(L"indication_id")->to_string();
 	std::vector<std::shared_ptr<container::value>> files = container->value_array(L"file");
 
 	std::vector<std::wstring> target_paths;
+	target_paths.reserve(files.size());
 	for (auto& file : files)
 	{
 		target_paths.push_back((*file)[L"target"]->to_string());
 	}
-	_file_manager.set(container->get_value(L"indication_id")->to_string(), target_paths);
+	_file_manager.set(indication_id, target_paths);
 
 	if (_middle_server)
 	{
-		_middle_server->send(std::make_shared<container::value_container>(container->source_id(), container->source_sub_id(), L"transfer_condition",
-			std::vector<std::shared_ptr<container::value>> {
-				std::make_shared<container::string_value>(L"indication_id", container->get_value(L"indication_id")->to_string()),
-				std::make_shared<container::ushort_value>(L"percentage", 0)
-		}));
+		transfer_condition condition;
+		condition.indication_id = indication_id;
+
+		_middle_server->send(container::message_schema<transfer_condition>::to_container(condition, container->source_id(), container->source_sub_id()));
 	}
 
 	std::shared_ptr<container::value_container> temp = container->copy();
@@ -516,22 +506,23 @@ bool upload_files(std::shared_ptr<container::value_container> container)
 		return false;
 	}
 
+	std::wstring indication_id = container->get_value(L"indication_id")->to_string();
 	std::vector<std::shared_ptr<container::value>> files = container->value_array(L"file");
 
 	std::vector<std::wstring> target_paths;
+	target_paths.reserve(files.size());
 	for (auto& file : files)
 	{
 		target_paths.push_back((*file)[L"target"]->to_string());
 	}
-	_file_manager.set(container->get_value(L"indication_id")->to_string(), target_paths);
+	_file_manager.set(indication_id, target_paths);
 
 	if (_middle_server)
 	{
-		_middle_server->send(std::make_shared<container::value_container>(container->source_id(), container->source_sub_id(), L"transfer_condition",
-			std::vector<std::shared_ptr<container::value>> {
-				std::make_shared<container::string_value>(L"indication_id", container->get_value(L"indication_id")->to_string()),
-				std::make_shared<container::ushort_value>(L"percentage", 0)
-		}));
+		transfer_condition condition;
+		condition.indication_id = indication_id;
+
+		_middle_server->send(container::message_schema<transfer_condition>::to_container(condition, container->source_id(), container->source_sub_id()));
 	}
 
 	container->set_message_type(L"transfer_file");
@@ -575,6 +566,8 @@ void display_help(void)
 	std::wcout << L"\tThe compress_mode on/off. If you want to use compress mode must be appended '--compress_mode true'.\n\tInitialize value is --compress_mode off." << std::endl << std::endl;
 	std::wcout << L"--compress_block_size [value]" << std::endl;
 	std::wcout << L"\tThe compress_mode on/off. If you want to change compress block size must be appended '--compress_block_size size'.\n\tInitialize value is --compress_mode 1024." << std::endl << std::endl;
+	std::wcout << L"--compress_codec [value]" << std::endl;
+	std::wcout << L"\tIf you want to change the codec used toward the main server while compress mode is on must be appended\n\t'--compress_codec [none|lz4|lz4hc|zstd][:level]'. Initialize value is --compress_codec lz4." << std::endl << std::endl;
 	std::wcout << L"--main_connection_key [value]" << std::endl;
 	std::wcout << L"\tIf you want to change a specific key string for the connection to the main server must be appended\n\t'--main_connection_key [specific key string]'." << std::endl << std::endl;
 	std::wcout << L"--middle_connection_key [value]" << std::endl;